@@ -1,10 +1,40 @@
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <numeric>
+#include <numbers>
+#include <optional>
+#include <random>
+#include <ranges>
 #include <set>
+#include <shared_mutex>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 // Niveles de la Taxonomía de Bloom
@@ -17,47 +47,706 @@ enum NivelBloom {
   CREAR = 6       // Creating - Nivel más alto (crear algo nuevo)
 };
 
+// Plantilla de texto precompilada - La fuente usa marcadores {{nombre}}. Al
+// compilarla se divide en segmentos (texto literal seguido de una variable),
+// así renderizar solo concatena sin volver a analizar la plantilla.
+class PlantillaTexto {
+public:
+  enum Variable {
+    VAR_TITULO,
+    VAR_ESTUDIANTE,
+    VAR_VARIANTE,
+    VAR_NUMERO,
+    VAR_TEXTO,
+    VAR_MINUTOS,
+    VAR_ETIQUETA,
+    VAR_IZQUIERDA,
+    VAR_DERECHA,
+    VAR_RESPUESTA,
+    CANTIDAD_VARIABLES
+  };
+
+  using Valores = std::array<std::string_view, CANTIDAD_VARIABLES>;
+  // Escapa un valor para el formato de salida y lo agrega al final
+  using Escapador = void (*)(std::string_view, std::string &);
+
+private:
+  struct Segmento {
+    std::string literal;
+    int variable = -1; // -1 = sin variable (último segmento)
+  };
+
+  std::vector<Segmento> segmentos;
+
+  static int buscarVariable(std::string_view nombre) {
+    static constexpr std::array<std::string_view, CANTIDAD_VARIABLES> nombres =
+        {"titulo",   "estudiante", "variante",  "numero",  "texto",
+         "minutos",  "etiqueta",   "izquierda", "derecha", "respuesta"};
+    auto it = std::ranges::find(nombres, nombre);
+    return it != nombres.end() ? static_cast<int>(it - nombres.begin()) : -1;
+  }
+
+public:
+  // Método para compilar la fuente. Devuelve false si un marcador no está
+  // cerrado o nombra una variable desconocida
+  bool compilar(std::string_view fuente) {
+    segmentos.clear();
+    std::size_t pos = 0;
+    while (true) {
+      std::size_t inicio = fuente.find("{{", pos);
+      if (inicio == std::string_view::npos) {
+        segmentos.push_back({std::string(fuente.substr(pos)), -1});
+        return true;
+      }
+      // En "{{{x}}}" la primera llave es literal
+      while (inicio + 2 < fuente.size() && fuente[inicio + 2] == '{') {
+        ++inicio;
+      }
+      std::size_t fin = fuente.find("}}", inicio + 2);
+      if (fin == std::string_view::npos) {
+        return false;
+      }
+      int variable =
+          buscarVariable(fuente.substr(inicio + 2, fin - inicio - 2));
+      if (variable < 0) {
+        return false;
+      }
+      segmentos.push_back(
+          {std::string(fuente.substr(pos, inicio - pos)), variable});
+      pos = fin + 2;
+    }
+  }
+
+  // Escribe un entero en 'buffer' y devuelve la vista del resultado
+  static std::string_view formatear(int valor, std::array<char, 12> &buffer) {
+    char *fin =
+        std::to_chars(buffer.data(), buffer.data() + buffer.size(), valor).ptr;
+    return {buffer.data(), static_cast<std::size_t>(fin - buffer.data())};
+  }
+
+  // Método para agregar la plantilla con los valores dados al final de
+  // 'salida'
+  void renderizar(const Valores &valores, Escapador escapar,
+                  std::string &salida) const {
+    for (const Segmento &segmento : segmentos) {
+      salida += segmento.literal;
+      if (segmento.variable >= 0) {
+        escapar(valores[segmento.variable], salida);
+      }
+    }
+  }
+};
+
+// Plantilla de examen - Conjunto de plantillas compiladas de un formato de
+// salida (una por cada parte del examen y de la pauta de respuestas)
+class PlantillaExamen {
+public:
+  enum Parte {
+    ENCABEZADO,      // titulo, estudiante, variante
+    PREGUNTA,        // numero, texto, minutos
+    FIN_PREGUNTA,    // numero
+    INICIO_OPCIONES, // Lista de opción múltiple
+    OPCION,          // etiqueta, texto
+    FIN_OPCIONES,
+    INICIO_TABLA, // Tabla de emparejamiento
+    FILA_TABLA,   // numero, izquierda, etiqueta, derecha
+    FIN_TABLA,
+    VERDADERO_FALSO, // numero
+    PIE,
+    ENCABEZADO_CLAVE, // titulo, estudiante, variante
+    ITEM_CLAVE,       // numero, respuesta
+    PIE_CLAVE,
+    CANTIDAD_PARTES
+  };
+
+  using Fuentes = std::array<std::string_view, CANTIDAD_PARTES>;
+
+private:
+  std::array<PlantillaTexto, CANTIDAD_PARTES> partes;
+  PlantillaTexto::Escapador escapador = nullptr;
+
+public:
+  // Método para compilar todas las partes. Devuelve false si alguna no es
+  // válida
+  bool compilar(const Fuentes &fuentes, PlantillaTexto::Escapador escapar) {
+    escapador = escapar;
+    for (int i = 0; i < CANTIDAD_PARTES; ++i) {
+      if (!partes[i].compilar(fuentes[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Método para agregar una parte del documento al final de 'salida'
+  void escribir(Parte parte, const PlantillaTexto::Valores &valores,
+                std::string &salida) const {
+    partes[parte].renderizar(valores, escapador, salida);
+  }
+
+  // Etiqueta de la alternativa en la posición k ('a', 'b', ... o 'A', ...)
+  static std::string etiqueta(int k, char primera) {
+    return k < 26 ? std::string(1, static_cast<char>(primera + k))
+                  : std::to_string(k + 1);
+  }
+
+  static void escaparLatex(std::string_view texto, std::string &salida) {
+    for (char c : texto) {
+      switch (c) {
+      case '\\':
+        salida += "\\textbackslash{}";
+        break;
+      case '~':
+        salida += "\\textasciitilde{}";
+        break;
+      case '^':
+        salida += "\\textasciicircum{}";
+        break;
+      case '&':
+      case '%':
+      case '$':
+      case '#':
+      case '_':
+      case '{':
+      case '}':
+        salida += '\\';
+        salida += c;
+        break;
+      default:
+        salida += c;
+      }
+    }
+  }
+
+  static void escaparHtml(std::string_view texto, std::string &salida) {
+    for (char c : texto) {
+      switch (c) {
+      case '&':
+        salida += "&amp;";
+        break;
+      case '<':
+        salida += "&lt;";
+        break;
+      case '>':
+        salida += "&gt;";
+        break;
+      case '"':
+        salida += "&quot;";
+        break;
+      case '\'':
+        salida += "&#39;";
+        break;
+      default:
+        salida += c;
+      }
+    }
+  }
+
+  // Plantillas predefinidas (se compilan una sola vez)
+  static const PlantillaExamen &latex() {
+    static const PlantillaExamen plantilla = [] {
+      PlantillaExamen p;
+      p.compilar(
+          {"\\documentclass{article}\n\\begin{document}\n"
+           "\\section*{{{titulo}}}\n"
+           "Estudiante: {{estudiante}} \\hfill Variante {{variante}}\n"
+           "\\begin{enumerate}\n",
+           "\\item {{texto}} \\hfill ({{minutos}} min)\n", "",
+           "\\begin{itemize}\n", "\\item[{{etiqueta}})] {{texto}}\n",
+           "\\end{itemize}\n", "\n\\begin{tabular}{rl|rl}\n",
+           "{{numero}} & {{izquierda}} & {{etiqueta}} & {{derecha}} \\\\\n",
+           "\\end{tabular}\n",
+           "\n$\\square$ Verdadero \\quad $\\square$ Falso\n",
+           "\\end{enumerate}\n\\end{document}\n",
+           "\\documentclass{article}\n\\begin{document}\n"
+           "\\section*{Pauta: {{titulo}}}\n"
+           "Estudiante: {{estudiante}} \\hfill Variante {{variante}}\n"
+           "\\begin{enumerate}\n",
+           "\\item {{respuesta}}\n", "\\end{enumerate}\n\\end{document}\n"},
+          escaparLatex);
+      return p;
+    }();
+    return plantilla;
+  }
+
+  static const PlantillaExamen &html() {
+    static const PlantillaExamen plantilla = [] {
+      PlantillaExamen p;
+      p.compilar(
+          {"<!DOCTYPE html>\n<html>\n<head><meta charset=\"utf-8\">"
+           "<title>{{titulo}}</title></head>\n<body>\n<h1>{{titulo}}</h1>\n"
+           "<p>Estudiante: {{estudiante}} &mdash; Variante {{variante}}</p>\n"
+           "<ol>\n",
+           "<li>\n<p>{{texto}} <small>({{minutos}} min)</small></p>\n",
+           "</li>\n", "<ul>\n", "<li>{{etiqueta}}) {{texto}}</li>\n",
+           "</ul>\n", "<table>\n",
+           "<tr><td>{{numero}}</td><td>{{izquierda}}</td>"
+           "<td>{{etiqueta}}</td><td>{{derecha}}</td></tr>\n",
+           "</table>\n", "<p>&#9744; Verdadero &#9744; Falso</p>\n",
+           "</ol>\n</body>\n</html>\n",
+           "<!DOCTYPE html>\n<html>\n<head><meta charset=\"utf-8\">"
+           "<title>Pauta: {{titulo}}</title></head>\n<body>\n"
+           "<h1>Pauta: {{titulo}}</h1>\n"
+           "<p>Estudiante: {{estudiante}} &mdash; Variante {{variante}}</p>\n"
+           "<ol>\n",
+           "<li>{{respuesta}}</li>\n", "</ol>\n</body>\n</html>\n"},
+          escaparHtml);
+      return p;
+    }();
+    return plantilla;
+  }
+};
+
+// Almacén de Textos Comprimidos - Tabla de hasta 255 símbolos de 1 a 8 bytes
+// compartida por todas las preguntas de un banco (al estilo FSST). Cada byte
+// comprimido es el código de un símbolo; el código ESCAPE va seguido de un
+// byte literal. La tabla se entrena con textos del banco y luego es de solo
+// lectura, así que comprimir y descomprimir no necesitan sincronización.
+// Además interna los textos de las listas: cada texto distinto se guarda una
+// sola vez (comprimido) mientras alguna lista lo use. La tabla de internados
+// está repartida en fragmentos con su propio mutex, y cada entrada se borra
+// cuando se suelta la última referencia a su texto.
+class AlmacenTextos {
+public:
+  static constexpr int MAX_SIMBOLOS = 255;
+  static constexpr unsigned char ESCAPE = 255;
+  static constexpr std::size_t LARGO_MAXIMO = 8;
+
+  struct Estadisticas {
+    std::size_t internados = 0;     // Textos distintos en uso
+    std::size_t referencias = 0;    // Veces que se pidió internar un texto
+    std::size_t bytesInternados = 0; // Bytes comprimidos de los distintos
+  };
+
+private:
+  std::array<std::array<char, LARGO_MAXIMO>, MAX_SIMBOLOS> simbolos{};
+  std::array<std::uint8_t, MAX_SIMBOLOS> largos{};
+  int cantidad = 0;
+  // Códigos según su primer byte, de mayor a menor largo
+  std::array<std::vector<std::uint8_t>, 256> porPrimerByte;
+
+  // Textos internados. Las claves apuntan al texto de cada entrada; el
+  // borrador del texto quita su entrada, así la clave nunca queda colgando.
+  // Los textos conservan la tabla mientras existan, aunque el almacén ya no
+  struct TablaInternados {
+    static constexpr std::size_t FRAGMENTOS = 16;
+    struct Fragmento {
+      std::mutex mutex;
+      std::unordered_map<std::string_view, std::weak_ptr<const std::string>>
+          textos;
+    };
+    std::array<Fragmento, FRAGMENTOS> fragmentos;
+    std::atomic<std::size_t> internados{0};
+    std::atomic<std::size_t> referencias{0};
+    std::atomic<std::size_t> bytes{0};
+  };
+  std::shared_ptr<TablaInternados> tabla =
+      std::make_shared<TablaInternados>();
+
+  // Código del símbolo más largo que empieza en texto[pos] (-1 si no hay)
+  int buscarSimbolo(std::string_view texto, std::size_t pos) const {
+    for (std::uint8_t codigo :
+         porPrimerByte[static_cast<unsigned char>(texto[pos])]) {
+      if (largos[codigo] <= texto.size() - pos &&
+          std::memcmp(simbolos[codigo].data(), texto.data() + pos,
+                      largos[codigo]) == 0) {
+        return codigo;
+      }
+    }
+    return -1;
+  }
+
+  void definirTabla(const std::vector<std::string> &nuevos) {
+    cantidad = static_cast<int>(nuevos.size());
+    for (auto &lista : porPrimerByte) {
+      lista.clear();
+    }
+    for (int codigo = 0; codigo < cantidad; ++codigo) {
+      simbolos[codigo] = {};
+      std::memcpy(simbolos[codigo].data(), nuevos[codigo].data(),
+                  nuevos[codigo].size());
+      largos[codigo] = static_cast<std::uint8_t>(nuevos[codigo].size());
+      porPrimerByte[static_cast<unsigned char>(nuevos[codigo][0])].push_back(
+          static_cast<std::uint8_t>(codigo));
+    }
+    for (auto &lista : porPrimerByte) {
+      std::ranges::sort(lista, [this](std::uint8_t a, std::uint8_t b) {
+        return largos[a] > largos[b];
+      });
+    }
+  }
+
+public:
+  // Método para entrenar una tabla con textos de muestra. En cada ronda se
+  // comprime la muestra con la tabla actual y se eligen los símbolos (o
+  // pares de símbolos consecutivos) que más bytes cubren
+  static std::shared_ptr<AlmacenTextos>
+  entrenar(const std::vector<std::string> &muestras, int rondas = 5,
+           std::size_t maxBytesMuestra = 1 << 18) {
+    auto almacen = std::make_shared<AlmacenTextos>();
+    for (int ronda = 0; ronda < rondas; ++ronda) {
+      std::unordered_map<std::string, std::uint64_t> ganancia;
+      std::size_t bytesUsados = 0;
+      for (const std::string &muestra : muestras) {
+        if (bytesUsados >= maxBytesMuestra) {
+          break;
+        }
+        bytesUsados += muestra.size();
+        std::string_view anterior;
+        for (std::size_t pos = 0; pos < muestra.size();) {
+          int codigo = almacen->buscarSimbolo(muestra, pos);
+          std::size_t largo = codigo >= 0 ? almacen->largos[codigo] : 1;
+          std::string_view actual(muestra.data() + pos, largo);
+          ganancia[std::string(actual)] += largo;
+          if (!anterior.empty() &&
+              anterior.size() + largo <= LARGO_MAXIMO) {
+            ganancia[std::string(anterior) + std::string(actual)] +=
+                anterior.size() + largo;
+          }
+          anterior = actual;
+          pos += largo;
+        }
+      }
+
+      std::vector<std::pair<std::uint64_t, std::string>> candidatos;
+      candidatos.reserve(ganancia.size());
+      for (auto &[simbolo, valor] : ganancia) {
+        candidatos.emplace_back(valor, simbolo);
+      }
+      std::size_t elegidos =
+          std::min<std::size_t>(candidatos.size(), MAX_SIMBOLOS);
+      std::partial_sort(candidatos.begin(), candidatos.begin() + elegidos,
+                        candidatos.end(), [](const auto &a, const auto &b) {
+                          return a.first != b.first ? a.first > b.first
+                                                    : a.second < b.second;
+                        });
+      std::vector<std::string> nuevos;
+      for (std::size_t i = 0; i < elegidos; ++i) {
+        nuevos.push_back(std::move(candidatos[i].second));
+      }
+      almacen->definirTabla(nuevos);
+    }
+    return almacen;
+  }
+
+  // Método para comprimir un texto
+  std::string comprimir(std::string_view texto) const {
+    std::string salida;
+    salida.reserve(texto.size());
+    for (std::size_t pos = 0; pos < texto.size();) {
+      int codigo = buscarSimbolo(texto, pos);
+      if (codigo < 0) {
+        salida += static_cast<char>(ESCAPE);
+        salida += texto[pos++];
+      } else {
+        salida += static_cast<char>(codigo);
+        pos += largos[codigo];
+      }
+    }
+    return salida;
+  }
+
+  // Método para descomprimir un texto. Una primera pasada valida los
+  // códigos y calcula el largo exacto; la segunda copia los símbolos.
+  // Devuelve false (sin tocar 'salida') si hay un código que no está en la
+  // tabla o un ESCAPE sin su byte literal
+  bool descomprimir(std::string_view comprimido, std::string &salida) const {
+    std::size_t largo = 0;
+    for (std::size_t i = 0; i < comprimido.size(); ++i) {
+      auto codigo = static_cast<unsigned char>(comprimido[i]);
+      if (codigo == ESCAPE) {
+        if (++i == comprimido.size()) {
+          return false;
+        }
+        largo++;
+      } else if (codigo < cantidad) {
+        largo += largos[codigo];
+      } else {
+        return false;
+      }
+    }
+
+    salida.resize(largo);
+    char *destino = salida.data();
+    for (std::size_t i = 0; i < comprimido.size(); ++i) {
+      auto codigo = static_cast<unsigned char>(comprimido[i]);
+      if (codigo == ESCAPE) {
+        *destino++ = comprimido[++i];
+      } else {
+        std::memcpy(destino, simbolos[codigo].data(), largos[codigo]);
+        destino += largos[codigo];
+      }
+    }
+    return true;
+  }
+
+  // Método para descomprimir un texto guardado por este almacén (siempre
+  // válido); con un texto inválido devuelve una cadena vacía
+  std::string descomprimir(std::string_view comprimido) const {
+    std::string salida;
+    if (!descomprimir(comprimido, salida)) {
+      salida.clear();
+    }
+    return salida;
+  }
+
+  // Método para comprimir e internar un texto. Los que piden el mismo texto
+  // comparten la copia, que se libera (y sale de la tabla) con la última
+  // referencia
+  std::shared_ptr<const std::string> internar(std::string_view texto) {
+    std::string comprimido = comprimir(texto);
+    tabla->referencias.fetch_add(1, std::memory_order_relaxed);
+    auto &fragmento =
+        tabla->fragmentos[std::hash<std::string_view>{}(comprimido) %
+                          TablaInternados::FRAGMENTOS];
+    std::lock_guard<std::mutex> lock(fragmento.mutex);
+    auto it = fragmento.textos.find(comprimido);
+    if (it != fragmento.textos.end()) {
+      if (auto vivo = it->second.lock()) {
+        return vivo;
+      }
+      // Su última referencia se está soltando: se reemplaza la entrada y el
+      // borrador, al ver que la clave ya no es suya, no la toca
+      fragmento.textos.erase(it);
+    }
+
+    auto borrar = [tabla = tabla, f = &fragmento](const std::string *t) {
+      {
+        std::lock_guard<std::mutex> lock(f->mutex);
+        auto entrada = f->textos.find(*t);
+        if (entrada != f->textos.end() &&
+            entrada->first.data() == t->data()) {
+          f->textos.erase(entrada);
+        }
+      }
+      tabla->internados.fetch_sub(1, std::memory_order_relaxed);
+      tabla->bytes.fetch_sub(t->size(), std::memory_order_relaxed);
+      delete t;
+    };
+    std::shared_ptr<const std::string> nuevo(
+        new std::string(std::move(comprimido)), std::move(borrar));
+    fragmento.textos.emplace(*nuevo, nuevo);
+    tabla->internados.fetch_add(1, std::memory_order_relaxed);
+    tabla->bytes.fetch_add(nuevo->size(), std::memory_order_relaxed);
+    return nuevo;
+  }
+
+  // Getters
+  int getCantidadSimbolos() const { return cantidad; }
+  Estadisticas getEstadisticas() const {
+    return {tabla->internados.load(std::memory_order_relaxed),
+            tabla->referencias.load(std::memory_order_relaxed),
+            tabla->bytes.load(std::memory_order_relaxed)};
+  }
+};
+
+// Lista de textos inmutable y compartida entre copias y versiones de una
+// pregunta. Sin almacén guarda los textos tal cual; con almacén guarda
+// referencias a los textos internados (comprimidos) y los descomprime al leer.
+class ListaTextos {
+private:
+  using TextoInternado = std::shared_ptr<const std::string>;
+
+  std::shared_ptr<const std::vector<std::string>> planos;
+  std::shared_ptr<const std::vector<TextoInternado>> comprimidos;
+  std::shared_ptr<AlmacenTextos> almacen;
+
+public:
+  // Constructor
+  ListaTextos(const std::vector<std::string> &textos = {},
+              std::shared_ptr<AlmacenTextos> almacen = nullptr)
+      : almacen(std::move(almacen)) {
+    if (!this->almacen) {
+      planos = std::make_shared<const std::vector<std::string>>(textos);
+      return;
+    }
+    std::vector<TextoInternado> internados;
+    internados.reserve(textos.size());
+    for (const std::string &texto : textos) {
+      internados.push_back(this->almacen->internar(texto));
+    }
+    comprimidos = std::make_shared<const std::vector<TextoInternado>>(
+        std::move(internados));
+  }
+
+  std::size_t size() const {
+    return almacen ? comprimidos->size() : planos->size();
+  }
+
+  std::string operator[](std::size_t i) const {
+    return almacen ? almacen->descomprimir(*(*comprimidos)[i]) : (*planos)[i];
+  }
+
+  // Iterador de entrada sobre los textos. Sin almacén entrega vistas de los
+  // textos guardados; con almacén descomprime cada texto en un buffer propio
+  // que se reutiliza, así recorrer la lista no crea un vector de copias. La
+  // vista es válida hasta avanzar el iterador
+  class Iterador {
+  private:
+    const ListaTextos *lista = nullptr;
+    std::size_t indice = 0;
+    mutable std::string buffer;
+
+  public:
+    using iterator_concept = std::input_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+
+    Iterador() = default;
+    Iterador(const ListaTextos *lista, std::size_t indice)
+        : lista(lista), indice(indice) {}
+
+    std::string_view operator*() const {
+      if (!lista->almacen) {
+        return (*lista->planos)[indice];
+      }
+      lista->almacen->descomprimir(*(*lista->comprimidos)[indice], buffer);
+      return buffer;
+    }
+    Iterador &operator++() {
+      ++indice;
+      return *this;
+    }
+    void operator++(int) { ++indice; }
+    bool operator==(const Iterador &otro) const {
+      return indice == otro.indice;
+    }
+  };
+
+  Iterador begin() const { return {this, 0}; }
+  Iterador end() const { return {this, size()}; }
+
+  // Método para obtener todos los textos descomprimidos
+  std::vector<std::string> aVector() const {
+    if (!almacen) {
+      return *planos;
+    }
+    std::vector<std::string> textos;
+    textos.reserve(comprimidos->size());
+    for (const TextoInternado &comprimido : *comprimidos) {
+      textos.push_back(almacen->descomprimir(*comprimido));
+    }
+    return textos;
+  }
+};
+
 // Clase base Pregunta - Define la estructura común para todos los tipos de
 // preguntas
 class Pregunta {
 protected:
   int id;             // Identificador único
-  std::string texto;  // Texto de la pregunta
   int nivelBloom;     // Nivel según taxonomía de Bloom
   int tiempoEstimado; // Tiempo estimado en minutos
   int anio;           // Año al que pertenece la pregunta
 
+  // Texto de la pregunta (comprimido si hay almacén). Es inmutable y se
+  // comparte entre copias y versiones, igual que las listas de opciones
+  std::shared_ptr<const std::string> texto;
+
+  // Parámetros IRT calibrados para tests adaptativos
+  double discriminacion = 1.0; // Parámetro a (1 = modelo de Rasch)
+  double dificultad = 0.0;     // Parámetro b (en la escala de habilidad)
+
+  int grupoTematico = -1; // Tema asignado por AgrupadorTematico (-1 = ninguno)
+
+  // Almacén con el que se comprimen los textos (nullptr = sin comprimir)
+  std::shared_ptr<AlmacenTextos> almacen;
+
 public:
   // Constructor - Inicializa los atributos básicos de una pregunta
   Pregunta(int id, const std::string &texto, int nivelBloom, int tiempoEstimado,
            int anio = 0)
-      : id(id), texto(texto), nivelBloom(nivelBloom),
-        tiempoEstimado(tiempoEstimado), anio(anio) {}
+      : id(id), nivelBloom(nivelBloom), tiempoEstimado(tiempoEstimado),
+        anio(anio), texto(std::make_shared<const std::string>(texto)) {}
 
   // Destructor virtual - Permite polimorfismo correcto al eliminar objetos
   virtual ~Pregunta() = default;
 
   // Getters - Métodos para obtener los valores de los atributos
   int getId() const { return id; }
-  std::string getTexto() const { return texto; }
+  std::string getTexto() const {
+    return almacen ? almacen->descomprimir(*texto) : *texto;
+  }
+  // Texto tal como se guarda (comprimido si la pregunta tiene almacén)
+  const std::string &getTextoGuardado() const { return *texto; }
   int getNivelBloom() const { return nivelBloom; }
   int getTiempoEstimado() const { return tiempoEstimado; }
   int getAnio() const { return anio; }
+  double getDiscriminacion() const { return discriminacion; }
+  double getDificultad() const { return dificultad; }
+  int getGrupoTematico() const { return grupoTematico; }
 
   // Setters - Métodos para modificar los valores de los atributos
-  void setTexto(const std::string &nuevoTexto) { texto = nuevoTexto; }
+  void setId(int nuevoId) { id = nuevoId; }
+  void setTexto(const std::string &nuevoTexto) {
+    texto = std::make_shared<const std::string>(
+        almacen ? almacen->comprimir(nuevoTexto) : nuevoTexto);
+  }
   void setNivelBloom(int nivel) { nivelBloom = nivel; }
   void setTiempoEstimado(int tiempo) { tiempoEstimado = tiempo; }
   void setAnio(int nuevoAnio) { anio = nuevoAnio; }
+  void setParametrosIRT(double nuevaDiscriminacion, double nuevaDificultad) {
+    discriminacion = nuevaDiscriminacion;
+    dificultad = nuevaDificultad;
+  }
+  void setGrupoTematico(int grupo) { grupoTematico = grupo; }
+
+  // Método virtual para cambiar el almacén de textos: los textos se
+  // descomprimen y se vuelven a guardar con el nuevo (nullptr = sin comprimir)
+  virtual void setAlmacenTextos(std::shared_ptr<AlmacenTextos> nuevo) {
+    std::string plano = getTexto();
+    almacen = std::move(nuevo);
+    setTexto(plano);
+  }
+  const std::shared_ptr<AlmacenTextos> &getAlmacenTextos() const {
+    return almacen;
+  }
 
   // Método virtual para obtener el tipo de pregunta - Será sobrescrito por
   // clases derivadas
   virtual std::string getTipo() const { return "Base"; }
 
+  // Método virtual para obtener todo el texto de la pregunta (enunciado y,
+  // en las clases derivadas, opciones o elementos)
+  virtual std::string getTextoCompleto() const { return getTexto(); }
+
+  // Cantidad de alternativas que una variante del examen puede reordenar
+  virtual int getCantidadAlternativas() const { return 0; }
+
+  // Método virtual para renderizar la pregunta con una plantilla de examen.
+  // orden[k] es la alternativa original que va en la posición k (vacío =
+  // orden original)
+  virtual void renderizar(const PlantillaExamen &plantilla, int numero,
+                          const std::vector<int> & /*orden*/,
+                          std::string &salida) const {
+    std::array<char, 12> bufNumero, bufMinutos;
+    PlantillaTexto::Valores valores{};
+    valores[PlantillaTexto::VAR_NUMERO] =
+        PlantillaTexto::formatear(numero, bufNumero);
+    valores[PlantillaTexto::VAR_MINUTOS] =
+        PlantillaTexto::formatear(tiempoEstimado, bufMinutos);
+    std::string enunciado = getTexto();
+    valores[PlantillaTexto::VAR_TEXTO] = enunciado;
+    plantilla.escribir(PlantillaExamen::PREGUNTA, valores, salida);
+  }
+
+  // Método virtual para obtener la respuesta correcta tal como aparece con
+  // el orden de alternativas dado
+  virtual std::string getRespuesta(const std::vector<int> & /*orden*/) const {
+    return "";
+  }
+
+  // Método virtual para copiar la pregunta conservando su tipo. Las listas de
+  // las clases derivadas se comparten con el original (copia perezosa)
+  virtual std::unique_ptr<Pregunta> clonar() const {
+    return std::make_unique<Pregunta>(*this);
+  }
+
   // Método para mostrar la información de la pregunta
   virtual void mostrar() const {
     std::cout << "ID: " << id << "\n";
-    std::cout << "Pregunta: " << texto << "\n";
+    std::cout << "Pregunta: " << getTexto() << "\n";
     std::cout << "Nivel de Bloom: " << getNombreNivelBloom(nivelBloom) << "\n";
     std::cout << "Tiempo Estimado: " << tiempoEstimado << " minutos\n";
     if (anio > 0) {
@@ -89,8 +778,10 @@ public:
 // Clase para preguntas de opción múltiple - Hereda de Pregunta
 class PreguntaOpcionMultiple : public Pregunta {
 private:
-  std::vector<std::string> opciones; // Lista de opciones disponibles
-  int opcionCorrecta;                // Índice de la opción correcta (0-based)
+  // Lista de opciones disponibles. Es inmutable y se comparte entre copias y
+  // versiones; un setter reemplaza la lista completa en vez de modificarla
+  ListaTextos opciones;
+  int opcionCorrecta; // Índice de la opción correcta (0-based)
 
 public:
   // Constructor
@@ -102,18 +793,72 @@ public:
         opciones(opciones), opcionCorrecta(opcionCorrecta) {}
 
   // Getters
-  std::vector<std::string> getOpciones() const { return opciones; }
+  const ListaTextos &getOpciones() const { return opciones; }
   int getOpcionCorrecta() const { return opcionCorrecta; }
 
   // Setters
   void setOpciones(const std::vector<std::string> &nuevasOpciones) {
-    opciones = nuevasOpciones;
+    opciones = ListaTextos(nuevasOpciones, almacen);
   }
   void setOpcionCorrecta(int opcion) { opcionCorrecta = opcion; }
 
   // Sobrescritura del método getTipo
   std::string getTipo() const override { return "Opción Múltiple"; }
 
+  // Sobrescritura del método setAlmacenTextos
+  void setAlmacenTextos(std::shared_ptr<AlmacenTextos> nuevo) override {
+    std::vector<std::string> planas = opciones.aVector();
+    Pregunta::setAlmacenTextos(std::move(nuevo));
+    opciones = ListaTextos(planas, almacen);
+  }
+
+  // Sobrescritura del método clonar
+  std::unique_ptr<Pregunta> clonar() const override {
+    return std::make_unique<PreguntaOpcionMultiple>(*this);
+  }
+
+  // Sobrescritura del método getTextoCompleto
+  std::string getTextoCompleto() const override {
+    std::string completo = getTexto();
+    for (std::string_view opcion : opciones) {
+      completo += '\n';
+      completo += opcion;
+    }
+    return completo;
+  }
+
+  // Sobrescritura de los métodos de renderizado
+  int getCantidadAlternativas() const override {
+    return static_cast<int>(opciones.size());
+  }
+
+  void renderizar(const PlantillaExamen &plantilla, int numero,
+                  const std::vector<int> &orden,
+                  std::string &salida) const override {
+    Pregunta::renderizar(plantilla, numero, orden, salida);
+    PlantillaTexto::Valores valores{};
+    plantilla.escribir(PlantillaExamen::INICIO_OPCIONES, valores, salida);
+    for (int k = 0; k < static_cast<int>(opciones.size()); ++k) {
+      std::string etiqueta = PlantillaExamen::etiqueta(k, 'a');
+      std::string opcion = opciones[orden.empty() ? k : orden[k]];
+      valores[PlantillaTexto::VAR_ETIQUETA] = etiqueta;
+      valores[PlantillaTexto::VAR_TEXTO] = opcion;
+      plantilla.escribir(PlantillaExamen::OPCION, valores, salida);
+    }
+    plantilla.escribir(PlantillaExamen::FIN_OPCIONES, valores, salida);
+  }
+
+  std::string getRespuesta(const std::vector<int> &orden) const override {
+    if (orden.empty()) {
+      return PlantillaExamen::etiqueta(opcionCorrecta, 'a');
+    }
+    auto it = std::ranges::find(orden, opcionCorrecta);
+    return it != orden.end()
+               ? PlantillaExamen::etiqueta(
+                     static_cast<int>(it - orden.begin()), 'a')
+               : "";
+  }
+
   // Sobrescritura del método mostrar
   void mostrar() const override {
     Pregunta::mostrar();
@@ -146,6 +891,27 @@ public:
   // Sobrescritura del método getTipo
   std::string getTipo() const override { return "Verdadero/Falso"; }
 
+  // Sobrescritura del método clonar
+  std::unique_ptr<Pregunta> clonar() const override {
+    return std::make_unique<PreguntaVerdaderoFalso>(*this);
+  }
+
+  // Sobrescritura de los métodos de renderizado
+  void renderizar(const PlantillaExamen &plantilla, int numero,
+                  const std::vector<int> &orden,
+                  std::string &salida) const override {
+    Pregunta::renderizar(plantilla, numero, orden, salida);
+    std::array<char, 12> bufNumero;
+    PlantillaTexto::Valores valores{};
+    valores[PlantillaTexto::VAR_NUMERO] =
+        PlantillaTexto::formatear(numero, bufNumero);
+    plantilla.escribir(PlantillaExamen::VERDADERO_FALSO, valores, salida);
+  }
+
+  std::string getRespuesta(const std::vector<int> & /*orden*/) const override {
+    return respuestaCorrecta ? "Verdadero" : "Falso";
+  }
+
   // Sobrescritura del método mostrar
   void mostrar() const override {
     Pregunta::mostrar();
@@ -158,12 +924,12 @@ public:
 // Clase para preguntas de emparejamiento - Hereda de Pregunta
 class PreguntaEmparejamiento : public Pregunta {
 private:
-  std::vector<std::string>
-      elementosIzquierda; // Elementos a emparejar (lado izquierdo)
-  std::vector<std::string>
-      elementosDerecha; // Elementos a emparejar (lado derecho)
-  std::vector<int> emparejamientosCorrectos; // Índices que indican el
-                                             // emparejamiento correcto
+  // Las listas son inmutables y se comparten entre copias y versiones
+  ListaTextos elementosIzquierda; // Elementos a emparejar (lado izquierdo)
+  ListaTextos elementosDerecha;   // Elementos a emparejar (lado derecho)
+  std::shared_ptr<const std::vector<int>>
+      emparejamientosCorrectos; // Índices que indican el emparejamiento
+                                // correcto
 
 public:
   // Constructor
@@ -176,33 +942,112 @@ public:
       : Pregunta(id, texto, nivelBloom, tiempoEstimado, anio),
         elementosIzquierda(elementosIzquierda),
         elementosDerecha(elementosDerecha),
-        emparejamientosCorrectos(emparejamientosCorrectos) {}
+        emparejamientosCorrectos(std::make_shared<const std::vector<int>>(
+            emparejamientosCorrectos)) {}
 
   // Getters
-  std::vector<std::string> getElementosIzquierda() const {
+  const ListaTextos &getElementosIzquierda() const {
     return elementosIzquierda;
   }
-  std::vector<std::string> getElementosDerecha() const {
-    return elementosDerecha;
-  }
-  std::vector<int> getEmparejamientosCorrectos() const {
-    return emparejamientosCorrectos;
+  const ListaTextos &getElementosDerecha() const { return elementosDerecha; }
+  const std::vector<int> &getEmparejamientosCorrectos() const {
+    return *emparejamientosCorrectos;
   }
 
   // Setters
   void setElementosIzquierda(const std::vector<std::string> &elementos) {
-    elementosIzquierda = elementos;
+    elementosIzquierda = ListaTextos(elementos, almacen);
   }
   void setElementosDerecha(const std::vector<std::string> &elementos) {
-    elementosDerecha = elementos;
+    elementosDerecha = ListaTextos(elementos, almacen);
   }
   void setEmparejamientosCorrectos(const std::vector<int> &emparejamientos) {
-    emparejamientosCorrectos = emparejamientos;
+    emparejamientosCorrectos =
+        std::make_shared<const std::vector<int>>(emparejamientos);
   }
 
   // Sobrescritura del método getTipo
   std::string getTipo() const override { return "Emparejamiento"; }
 
+  // Sobrescritura del método setAlmacenTextos
+  void setAlmacenTextos(std::shared_ptr<AlmacenTextos> nuevo) override {
+    std::vector<std::string> izquierda = elementosIzquierda.aVector();
+    std::vector<std::string> derecha = elementosDerecha.aVector();
+    Pregunta::setAlmacenTextos(std::move(nuevo));
+    elementosIzquierda = ListaTextos(izquierda, almacen);
+    elementosDerecha = ListaTextos(derecha, almacen);
+  }
+
+  // Sobrescritura del método clonar
+  std::unique_ptr<Pregunta> clonar() const override {
+    return std::make_unique<PreguntaEmparejamiento>(*this);
+  }
+
+  // Sobrescritura del método getTextoCompleto
+  std::string getTextoCompleto() const override {
+    std::string completo = getTexto();
+    for (const ListaTextos *lista : {&elementosIzquierda, &elementosDerecha}) {
+      for (std::string_view elemento : *lista) {
+        completo += '\n';
+        completo += elemento;
+      }
+    }
+    return completo;
+  }
+
+  // Sobrescritura de los métodos de renderizado. Las variantes reordenan
+  // la columna derecha
+  int getCantidadAlternativas() const override {
+    return static_cast<int>(elementosDerecha.size());
+  }
+
+  void renderizar(const PlantillaExamen &plantilla, int numero,
+                  const std::vector<int> &orden,
+                  std::string &salida) const override {
+    Pregunta::renderizar(plantilla, numero, orden, salida);
+    PlantillaTexto::Valores valores{};
+    plantilla.escribir(PlantillaExamen::INICIO_TABLA, valores, salida);
+    int izquierda = static_cast<int>(elementosIzquierda.size());
+    int derecha = static_cast<int>(elementosDerecha.size());
+    for (int fila = 0; fila < std::max(izquierda, derecha); ++fila) {
+      std::array<char, 12> bufNumero;
+      std::string etiqueta, textoIzquierda, textoDerecha;
+      valores = {};
+      if (fila < izquierda) {
+        textoIzquierda = elementosIzquierda[fila];
+        valores[PlantillaTexto::VAR_NUMERO] =
+            PlantillaTexto::formatear(fila + 1, bufNumero);
+        valores[PlantillaTexto::VAR_IZQUIERDA] = textoIzquierda;
+      }
+      if (fila < derecha) {
+        etiqueta = PlantillaExamen::etiqueta(fila, 'A');
+        textoDerecha = elementosDerecha[orden.empty() ? fila : orden[fila]];
+        valores[PlantillaTexto::VAR_ETIQUETA] = etiqueta;
+        valores[PlantillaTexto::VAR_DERECHA] = textoDerecha;
+      }
+      plantilla.escribir(PlantillaExamen::FILA_TABLA, valores, salida);
+    }
+    plantilla.escribir(PlantillaExamen::FIN_TABLA, valores, salida);
+  }
+
+  std::string getRespuesta(const std::vector<int> &orden) const override {
+    // Posición en la que quedó cada elemento derecho original
+    std::vector<int> posicion(elementosDerecha.size());
+    for (int k = 0; k < static_cast<int>(posicion.size()); ++k) {
+      posicion[orden.empty() ? k : orden[k]] = k;
+    }
+    std::string respuesta;
+    for (std::size_t i = 0; i < emparejamientosCorrectos->size(); ++i) {
+      int original = (*emparejamientosCorrectos)[i];
+      if (original < 0 || original >= static_cast<int>(posicion.size())) {
+        continue;
+      }
+      respuesta += (respuesta.empty() ? "" : ", ") + std::to_string(i + 1) +
+                   "-" + PlantillaExamen::etiqueta(posicion[original], 'A');
+    }
+    return respuesta;
+  }
+
   // Sobrescritura del método mostrar
   void mostrar() const override {
     Pregunta::mostrar();
@@ -217,198 +1062,5941 @@ public:
                 << "\n";
     }
     std::cout << "Emparejamientos Correctos:\n";
-    for (size_t i = 0; i < emparejamientosCorrectos.size(); ++i) {
+    for (size_t i = 0; i < emparejamientosCorrectos->size(); ++i) {
       std::cout << "  " << (i + 1) << " -> "
-                << (char)('A' + emparejamientosCorrectos[i]) << "\n";
+                << (char)('A' + (*emparejamientosCorrectos)[i]) << "\n";
     }
   }
 };
 
-// Gestor de Preguntas - Maneja la colección de preguntas y operaciones CRUD
-class GestorPreguntas {
+// Pool de hilos con robo de trabajo (work stealing). Cada hilo tiene su propia
+// cola: toma tareas del final (las más recientes, con datos aún en caché) y,
+// cuando se queda sin trabajo, roba del principio de las colas de los demás.
+// Un hilo que espera un resultado ejecuta tareas pendientes mientras tanto,
+// por lo que las tareas pueden lanzar y esperar subtareas sin bloquear el pool.
+// Si no queda nada que ejecutar, duerme hasta que llegue otra tarea o termine
+// alguna de las que están en curso.
+class PoolHilos {
 private:
-  std::vector<std::unique_ptr<Pregunta>>
-      preguntas;       // Almacena todas las preguntas
-  int siguienteId = 1; // ID para la siguiente pregunta
+  // Cola de trabajo de un hilo
+  struct ColaTrabajo {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tareas;
+  };
+
+  std::vector<std::unique_ptr<ColaTrabajo>> colas;
+  std::vector<std::thread> hilos;
+  std::atomic<std::size_t> pendientes{0};    // Tareas encoladas sin empezar
+  std::atomic<std::size_t> siguienteCola{0}; // Reparto de tareas externas
+  std::atomic<std::size_t> esperando{0};     // Hilos dormidos en esperar
+  std::mutex mutexEspera;
+  std::condition_variable hayTareas; // Llegó una tarea o terminó una
+  bool detenido = false;
+
+  // Pool e índice de cola del hilo actual (nullptr fuera de un pool)
+  inline static thread_local PoolHilos *poolActual = nullptr;
+  inline static thread_local std::size_t colaActual = 0;
+
+  // Toma una tarea de la cola propia o, si está vacía, la roba de otra
+  bool tomarTarea(std::size_t indice, std::function<void()> &tarea) {
+    {
+      ColaTrabajo &propia = *colas[indice];
+      std::lock_guard<std::mutex> lock(propia.mutex);
+      if (!propia.tareas.empty()) {
+        tarea = std::move(propia.tareas.back());
+        propia.tareas.pop_back();
+        pendientes--;
+        return true;
+      }
+    }
+    for (std::size_t k = 1; k < colas.size(); ++k) {
+      ColaTrabajo &victima = *colas[(indice + k) % colas.size()];
+      std::lock_guard<std::mutex> lock(victima.mutex);
+      if (!victima.tareas.empty()) {
+        tarea = std::move(victima.tareas.front());
+        victima.tareas.pop_front();
+        pendientes--;
+        return true;
+      }
+    }
+    return false;
+  }
 
-  // Mapas para validación de preguntas repetidas
-  std::map<int, std::set<std::string>> preguntasPorAnio; // Preguntas por año
-  std::map<std::string, int> textoAPreguntaId;           // Mapeo de texto a ID
+  // Ejecuta una tarea y despierta a los hilos que esperan un resultado,
+  // si hay alguno. La barrera ordena el fin de la tarea antes de leer
+  // 'esperando' (y en esperarHasta, el aumento antes de revisar la
+  // condición), así que no se pierde el aviso
+  void ejecutar(std::function<void()> &tarea) {
+    tarea();
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (esperando.load(std::memory_order_relaxed) > 0) {
+      {
+        std::lock_guard<std::mutex> lock(mutexEspera);
+      }
+      hayTareas.notify_all();
+    }
+  }
 
-  // Verifica si una pregunta es similar a otra existente
-  bool esPreguntaSimilar(const std::string &texto, int anio) {
-    // Verificar si la pregunta existe exactamente en el mismo año
-    if (anio > 0 && preguntasPorAnio.count(anio) > 0) {
-      if (preguntasPorAnio[anio].count(texto) > 0) {
-        return true;
+  // Bucle de cada hilo: ejecuta o roba tareas hasta que el pool se detiene
+  void trabajar(std::size_t indice) {
+    poolActual = this;
+    colaActual = indice;
+    while (true) {
+      std::function<void()> tarea;
+      if (tomarTarea(indice, tarea)) {
+        ejecutar(tarea);
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(mutexEspera);
+      hayTareas.wait(lock, [this] { return detenido || pendientes > 0; });
+      if (detenido && pendientes == 0) {
+        return;
+      }
+    }
+  }
+
+  // Encola una tarea: en la cola propia si se llama desde un hilo del pool,
+  // o repartida entre las colas si se llama desde fuera
+  void encolar(std::function<void()> tarea) {
+    std::size_t indice = poolActual == this
+                             ? colaActual
+                             : siguienteCola.fetch_add(1) % colas.size();
+    {
+      std::lock_guard<std::mutex> lock(colas[indice]->mutex);
+      colas[indice]->tareas.push_back(std::move(tarea));
+    }
+    pendientes++;
+    {
+      // Sincroniza con los hilos que están por dormir para no perder el aviso
+      std::lock_guard<std::mutex> lock(mutexEspera);
+    }
+    hayTareas.notify_one();
+  }
+
+  // Ejecuta una tarea pendiente en el hilo actual; false si no había ninguna
+  bool ayudar() {
+    std::function<void()> tarea;
+    std::size_t indice = poolActual == this ? colaActual : 0;
+    if (!tomarTarea(indice, tarea)) {
+      return false;
+    }
+    ejecutar(tarea);
+    return true;
+  }
+
+  // Espera a que se cumpla 'listo' ayudando con las tareas pendientes. Sin
+  // tareas que ejecutar, duerme en vez de girar: lo despierta una tarea
+  // nueva o el fin de cualquier tarea
+  template <typename Condicion> void esperarHasta(Condicion listo) {
+    while (!listo()) {
+      if (ayudar()) {
+        continue;
+      }
+      esperando.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      {
+        std::unique_lock<std::mutex> lock(mutexEspera);
+        hayTareas.wait(lock, [&] { return listo() || pendientes > 0; });
+      }
+      esperando.fetch_sub(1);
+    }
+  }
+
+public:
+  // Constructor - Por defecto usa un hilo por núcleo
+  explicit PoolHilos(std::size_t cantidadHilos = 0) {
+    if (cantidadHilos == 0) {
+      cantidadHilos = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (std::size_t i = 0; i < cantidadHilos; ++i) {
+      colas.push_back(std::make_unique<ColaTrabajo>());
+    }
+    for (std::size_t i = 0; i < cantidadHilos; ++i) {
+      hilos.emplace_back([this, i] { trabajar(i); });
+    }
+  }
+
+  // Destructor - Termina las tareas pendientes y espera a los hilos
+  ~PoolHilos() {
+    {
+      std::lock_guard<std::mutex> lock(mutexEspera);
+      detenido = true;
+    }
+    hayTareas.notify_all();
+    for (auto &hilo : hilos) {
+      hilo.join();
+    }
+  }
+
+  PoolHilos(const PoolHilos &) = delete;
+  PoolHilos &operator=(const PoolHilos &) = delete;
+
+  // Pool compartido por todo el programa; se crea la primera vez que se usa
+  static PoolHilos &global() {
+    static PoolHilos pool;
+    return pool;
+  }
+
+  // Método para encolar una tarea y obtener su resultado a futuro
+  template <typename Funcion>
+  std::future<std::invoke_result_t<Funcion>> enviar(Funcion funcion) {
+    using Resultado = std::invoke_result_t<Funcion>;
+    auto tarea =
+        std::make_shared<std::packaged_task<Resultado()>>(std::move(funcion));
+    std::future<Resultado> futuro = tarea->get_future();
+    encolar([tarea] { (*tarea)(); });
+    return futuro;
+  }
+
+  // Método para esperar un resultado ejecutando otras tareas mientras tanto
+  template <typename Resultado>
+  Resultado esperar(std::future<Resultado> &futuro) {
+    esperarHasta([&futuro] {
+      return futuro.wait_for(std::chrono::seconds(0)) ==
+             std::future_status::ready;
+    });
+    return futuro.get();
+  }
+
+  // Método para procesar [0, cantidad) en bloques de 'tamBloque' elementos.
+  // Llama funcion(bloque, inicio, fin) una vez por bloque, en paralelo, y
+  // vuelve cuando terminaron todos. El primer bloque lo procesa el llamador
+  template <typename Funcion>
+  void paraCadaBloque(std::size_t cantidad, std::size_t tamBloque,
+                      Funcion funcion) {
+    std::size_t bloques = (cantidad + tamBloque - 1) / tamBloque;
+    if (bloques == 0) {
+      return;
+    }
+
+    std::atomic<std::size_t> restantes(bloques);
+    std::exception_ptr error;
+    std::mutex mutexError;
+    auto procesar = [&](std::size_t bloque) {
+      try {
+        funcion(bloque, bloque * tamBloque,
+                std::min(cantidad, (bloque + 1) * tamBloque));
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutexError);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+      restantes.fetch_sub(1, std::memory_order_release);
+    };
+
+    for (std::size_t bloque = 1; bloque < bloques; ++bloque) {
+      encolar([&procesar, bloque] { procesar(bloque); });
+    }
+    procesar(0);
+    esperarHasta([&restantes] {
+      return restantes.load(std::memory_order_acquire) == 0;
+    });
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  std::size_t getCantidadHilos() const { return hilos.size(); }
+};
+
+// Motor de escaneo paralelo - Filtra y reduce colecciones grandes dividiéndolas
+// en bloques (morsels) del tamaño de la caché que se reparten en el pool. Los
+// resultados parciales se unen en el orden original. Por debajo del umbral
+// el escaneo es secuencial, porque repartir costaría más que recorrer.
+class MotorEscaneoParalelo {
+private:
+  PoolHilos *pool;          // nullptr = pool global
+  std::size_t umbralSerial; // Tamaño mínimo para escanear en paralelo
+  std::size_t tamMorsel;    // Elementos por bloque
+
+  PoolHilos &getPool() const { return pool ? *pool : PoolHilos::global(); }
+
+public:
+  // Constructor
+  explicit MotorEscaneoParalelo(PoolHilos *pool = nullptr,
+                                std::size_t umbralSerial = 32 * 1024,
+                                std::size_t tamMorsel = 16 * 1024)
+      : pool(pool), umbralSerial(umbralSerial),
+        tamMorsel(std::max<std::size_t>(1, tamMorsel)) {}
+
+  // Método para filtrar: devuelve proyeccion(x) de cada x que cumple el
+  // predicado, en el mismo orden que 'datos'
+  template <typename Contenedor, typename Predicado, typename Proyeccion>
+  auto filtrar(const Contenedor &datos, Predicado predicado,
+               Proyeccion proyeccion) const {
+    using Salida = std::decay_t<
+        std::invoke_result_t<Proyeccion, decltype(*std::begin(datos))>>;
+    std::vector<Salida> resultado;
+    std::size_t cantidad = std::size(datos);
+
+    if (cantidad < umbralSerial) {
+      for (const auto &x : datos) {
+        if (predicado(x)) {
+          resultado.push_back(proyeccion(x));
+        }
+      }
+      return resultado;
+    }
+
+    std::vector<std::vector<Salida>> parciales((cantidad + tamMorsel - 1) /
+                                               tamMorsel);
+    getPool().paraCadaBloque(
+        cantidad, tamMorsel,
+        [&](std::size_t bloque, std::size_t inicio, std::size_t fin) {
+          auto &parcial = parciales[bloque];
+          for (std::size_t i = inicio; i < fin; ++i) {
+            if (predicado(datos[i])) {
+              parcial.push_back(proyeccion(datos[i]));
+            }
+          }
+        });
+
+    std::size_t total = 0;
+    for (const auto &parcial : parciales) {
+      total += parcial.size();
+    }
+    resultado.reserve(total);
+    for (const auto &parcial : parciales) {
+      resultado.insert(resultado.end(), parcial.begin(), parcial.end());
+    }
+    return resultado;
+  }
+
+  // Método para reducir: combina mapeo(x) de todos los elementos. 'combinar'
+  // debe ser asociativa; los parciales se combinan en el orden original
+  template <typename Contenedor, typename Valor, typename Mapeo,
+            typename Combinar>
+  Valor reducir(const Contenedor &datos, Valor inicial, Mapeo mapeo,
+                Combinar combinar) const {
+    std::size_t cantidad = std::size(datos);
+
+    if (cantidad < umbralSerial) {
+      for (const auto &x : datos) {
+        inicial = combinar(std::move(inicial), mapeo(x));
+      }
+      return inicial;
+    }
+
+    std::vector<std::optional<Valor>> parciales((cantidad + tamMorsel - 1) /
+                                                tamMorsel);
+    getPool().paraCadaBloque(
+        cantidad, tamMorsel,
+        [&](std::size_t bloque, std::size_t inicio, std::size_t fin) {
+          Valor parcial = mapeo(datos[inicio]);
+          for (std::size_t i = inicio + 1; i < fin; ++i) {
+            parcial = combinar(std::move(parcial), mapeo(datos[i]));
+          }
+          parciales[bloque] = std::move(parcial);
+        });
+
+    for (auto &parcial : parciales) {
+      inicial = combinar(std::move(inicial), std::move(*parcial));
+    }
+    return inicial;
+  }
+
+  // Método para contar los elementos que cumplen un predicado
+  template <typename Contenedor, typename Predicado>
+  std::size_t contar(const Contenedor &datos, Predicado predicado) const {
+    return reducir(
+        datos, std::size_t{0},
+        [&predicado](const auto &x) -> std::size_t {
+          return predicado(x) ? 1 : 0;
+        },
+        std::plus<std::size_t>());
+  }
+};
+
+// Consulta combinada sobre el banco. Los campos con CUALQUIERA no filtran.
+struct ConsultaPreguntas {
+  static constexpr int CUALQUIERA = -1;
+
+  int nivelBloom = CUALQUIERA; // Nivel de Bloom (1-6)
+  int anio = CUALQUIERA;       // Año (0 = preguntas sin año)
+
+  // Indica si una pregunta con ese nivel y año forma parte del resultado
+  bool coincide(int nivel, int anioPregunta) const {
+    return (nivelBloom == CUALQUIERA || nivelBloom == nivel) &&
+           (anio == CUALQUIERA || anio == anioPregunta);
+  }
+
+  // Indica si la consulta puede tener resultados: nivel 1-6 y año >= 0,
+  // o CUALQUIERA en cada campo
+  bool esValida() const {
+    return (nivelBloom == CUALQUIERA ||
+            (nivelBloom >= RECORDAR && nivelBloom <= CREAR)) &&
+           (anio == CUALQUIERA || anio >= 0);
+  }
+
+  // Clave de la consulta. Guarda los valores tal cual, igual que los compara
+  // coincide(), para que dos consultas con la misma clave filtren lo mismo
+  std::uint64_t getClave() const {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(nivelBloom))
+            << 32) |
+           static_cast<std::uint32_t>(anio);
+  }
+};
+
+// Caché LRU de resultados de búsqueda. Está limitada por cantidad de entradas
+// y por memoria aproximada. Una pregunta de nivel N y año A solo puede
+// aparecer en las consultas (N, A), (N, *), (*, A) y (*, *), por lo que al
+// cambiar esa pregunta se desalojan exactamente esas cuatro entradas.
+class CacheConsultas {
+public:
+  // Contadores de uso de la caché
+  struct Estadisticas {
+    std::size_t aciertos = 0;       // Consultas respondidas desde la caché
+    std::size_t fallos = 0;         // Consultas que hubo que calcular
+    std::size_t desalojos = 0;      // Entradas descartadas por los límites
+    std::size_t invalidaciones = 0; // Entradas descartadas por cambios
+  };
+
+private:
+  struct Entrada {
+    std::uint64_t clave;
+    std::vector<const Pregunta *> resultado;
+  };
+
+  std::list<Entrada> entradas; // La más reciente al frente
+  std::unordered_map<std::uint64_t, std::list<Entrada>::iterator> indice;
+  std::size_t maxEntradas;
+  std::size_t maxBytes;
+  std::size_t bytesUsados = 0;
+  Estadisticas estadisticas;
+
+  // Memoria aproximada que ocupa una entrada
+  static std::size_t calcularBytes(const Entrada &entrada) {
+    return sizeof(Entrada) + 4 * sizeof(void *) +
+           entrada.resultado.capacity() * sizeof(const Pregunta *);
+  }
+
+  void descartar(std::list<Entrada>::iterator it) {
+    bytesUsados -= calcularBytes(*it);
+    indice.erase(it->clave);
+    entradas.erase(it);
+  }
+
+public:
+  // Constructor - Límite de entradas y de memoria (en bytes)
+  explicit CacheConsultas(std::size_t maxEntradas = 256,
+                          std::size_t maxBytes = 4 * 1024 * 1024)
+      : maxEntradas(maxEntradas), maxBytes(maxBytes) {}
+
+  // Busca el resultado de una consulta; nullptr si no está en caché
+  const std::vector<const Pregunta *> *
+  buscar(const ConsultaPreguntas &consulta) {
+    auto it = indice.find(consulta.getClave());
+    if (it == indice.end()) {
+      estadisticas.fallos++;
+      return nullptr;
+    }
+    estadisticas.aciertos++;
+    entradas.splice(entradas.begin(), entradas, it->second);
+    return &it->second->resultado;
+  }
+
+  // Guarda el resultado de una consulta, desalojando las menos usadas
+  void guardar(const ConsultaPreguntas &consulta,
+               std::vector<const Pregunta *> resultado) {
+    std::uint64_t clave = consulta.getClave();
+    if (auto it = indice.find(clave); it != indice.end()) {
+      descartar(it->second);
+    }
+
+    Entrada entrada{clave, std::move(resultado)};
+    std::size_t bytes = calcularBytes(entrada);
+    if (bytes > maxBytes || maxEntradas == 0) {
+      return; // El resultado no cabe en la caché
+    }
+
+    while (!entradas.empty() &&
+           (entradas.size() >= maxEntradas || bytesUsados + bytes > maxBytes)) {
+      descartar(std::prev(entradas.end()));
+      estadisticas.desalojos++;
+    }
+
+    entradas.push_front(std::move(entrada));
+    indice[clave] = entradas.begin();
+    bytesUsados += bytes;
+  }
+
+  // Desaloja las consultas que podrían contener una pregunta con ese nivel
+  // de Bloom y año
+  void invalidar(int nivelBloom, int anio) {
+    const int C = ConsultaPreguntas::CUALQUIERA;
+    for (ConsultaPreguntas consulta : {ConsultaPreguntas{nivelBloom, anio},
+                                       ConsultaPreguntas{nivelBloom, C},
+                                       ConsultaPreguntas{C, anio},
+                                       ConsultaPreguntas{C, C}}) {
+      auto it = indice.find(consulta.getClave());
+      if (it != indice.end()) {
+        descartar(it->second);
+        estadisticas.invalidaciones++;
+      }
+    }
+  }
+
+  // Vacía la caché
+  void limpiar() {
+    entradas.clear();
+    indice.clear();
+    bytesUsados = 0;
+  }
+
+  // Getters
+  const Estadisticas &getEstadisticas() const { return estadisticas; }
+  std::size_t getCantidadEntradas() const { return entradas.size(); }
+  std::size_t getBytesUsados() const { return bytesUsados; }
+};
+
+// Tipos de cambio publicados por el gestor
+enum TipoCambio {
+  CAMBIO_ALTA = 1,         // Pregunta agregada (o restaurada)
+  CAMBIO_MODIFICACION = 2, // Pregunta actualizada
+  CAMBIO_BAJA = 3          // Pregunta eliminada
+};
+
+// Evento de cambio con las imágenes anterior y posterior de la pregunta.
+// Las imágenes son versiones del historial del gestor: son inmutables y
+// siguen siendo válidas mientras exista el gestor que las publicó.
+struct EventoCambio {
+  std::uint64_t secuencia = 0; // Número de orden, empieza en 1
+  TipoCambio tipo = CAMBIO_ALTA;
+  int id = 0;
+  const Pregunta *antes = nullptr;   // nullptr en un alta
+  const Pregunta *despues = nullptr; // nullptr en una baja
+};
+
+// Flujo de Cambios - Buffer circular sin bloqueos con un productor y varios
+// consumidores. Cada ranura funciona como un seqlock: el productor la marca
+// como "en escritura", escribe los campos y publica el número de secuencia;
+// el consumidor copia los campos y verifica que la secuencia no cambió
+// mientras leía. Cada consumidor avanza con su propio cursor.
+class FlujoCambios {
+public:
+  // Qué hace el productor cuando el consumidor más lento no liberó espacio
+  enum PoliticaLlenado {
+    BLOQUEAR,    // Espera a que los consumidores avancen (con un máximo)
+    SOBRESCRIBIR // Sigue escribiendo; los consumidores lentos pierden eventos
+  };
+
+  // Resultado de intentar leer un evento
+  enum EstadoLectura {
+    LEIDO,     // Se obtuvo el siguiente evento
+    SIN_DATOS, // Aún no hay eventos nuevos
+    PERDIDO    // El evento fue sobrescrito: hay que reanudar o reconstruir
+  };
+
+  static constexpr std::size_t MAX_SUSCRIPTORES = 64;
+
+private:
+  static constexpr std::uint64_t ESCRIBIENDO =
+      std::numeric_limits<std::uint64_t>::max();
+
+  struct Ranura {
+    std::atomic<std::uint64_t> secuencia{0};
+    std::atomic<int> tipo{0};
+    std::atomic<int> id{0};
+    std::atomic<const Pregunta *> antes{nullptr};
+    std::atomic<const Pregunta *> despues{nullptr};
+  };
+
+  std::size_t capacidad; // Potencia de dos
+  std::unique_ptr<Ranura[]> ranuras;
+  std::atomic<std::uint64_t> ultimaPublicada{0};
+  // Próxima secuencia que leerá cada suscriptor (0 = posición libre)
+  std::array<std::atomic<std::uint64_t>, MAX_SUSCRIPTORES> cursores{};
+  PoliticaLlenado politica;
+  // Con BLOQUEAR, cuánto espera el productor antes de sobrescribir: un
+  // suscriptor detenido no puede detener al banco
+  std::chrono::microseconds esperaMaxima;
+  std::atomic<std::uint64_t> escriturasForzadas{0}; // Esperas agotadas
+
+  // Cursor del suscriptor más atrasado (0 si no hay suscriptores)
+  std::uint64_t cursorMinimo() const {
+    std::uint64_t minimo = 0;
+    for (const auto &cursor : cursores) {
+      std::uint64_t c = cursor.load(std::memory_order_acquire);
+      if (c != 0 && (minimo == 0 || c < minimo)) {
+        minimo = c;
+      }
+    }
+    return minimo;
+  }
+
+public:
+  // Suscriptor - Lee los eventos en orden desde su propio cursor
+  class Suscriptor {
+  private:
+    FlujoCambios &flujo;
+    std::atomic<std::uint64_t> &cursor;
+
+  public:
+    Suscriptor(FlujoCambios &flujo, std::atomic<std::uint64_t> &cursor)
+        : flujo(flujo), cursor(cursor) {}
+    ~Suscriptor() { cursor.store(0, std::memory_order_release); }
+
+    Suscriptor(const Suscriptor &) = delete;
+    Suscriptor &operator=(const Suscriptor &) = delete;
+
+    // Método para leer el siguiente evento sin bloquear
+    EstadoLectura leer(EventoCambio &evento) {
+      std::uint64_t s = cursor.load(std::memory_order_relaxed);
+      if (s > flujo.ultimaPublicada.load(std::memory_order_acquire)) {
+        return SIN_DATOS;
+      }
+      const Ranura &ranura = flujo.ranuras[s & (flujo.capacidad - 1)];
+      if (ranura.secuencia.load(std::memory_order_acquire) != s) {
+        return PERDIDO;
+      }
+      evento.secuencia = s;
+      evento.tipo =
+          static_cast<TipoCambio>(ranura.tipo.load(std::memory_order_relaxed));
+      evento.id = ranura.id.load(std::memory_order_relaxed);
+      evento.antes = ranura.antes.load(std::memory_order_relaxed);
+      evento.despues = ranura.despues.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (ranura.secuencia.load(std::memory_order_relaxed) != s) {
+        return PERDIDO; // El productor la reescribió mientras se leía
+      }
+      cursor.store(s + 1, std::memory_order_release);
+      return LEIDO;
+    }
+
+    // Método para reanudar la lectura desde una secuencia. Devuelve false si
+    // esa secuencia ya no está en el buffer o aún no se publicó (se puede
+    // reanudar justo después del último cambio, para leer solo los nuevos)
+    bool reanudarDesde(std::uint64_t secuencia) {
+      if (secuencia < flujo.getSecuenciaMasAntigua() ||
+          secuencia > flujo.getUltimaSecuencia() + 1) {
+        return false;
+      }
+      cursor.store(secuencia, std::memory_order_release);
+      return true;
+    }
+
+    std::uint64_t getSiguienteSecuencia() const {
+      return cursor.load(std::memory_order_relaxed);
+    }
+  };
+
+  // Constructor - La capacidad se redondea a la siguiente potencia de dos
+  explicit FlujoCambios(
+      std::size_t capacidadMinima = 4096,
+      PoliticaLlenado politica = SOBRESCRIBIR,
+      std::chrono::microseconds esperaMaxima = std::chrono::milliseconds(100))
+      : capacidad(std::bit_ceil(std::max<std::size_t>(capacidadMinima, 2))),
+        ranuras(new Ranura[capacidad]), politica(politica),
+        esperaMaxima(esperaMaxima) {}
+
+  // Método para publicar un evento (solo desde el hilo productor). Devuelve
+  // la secuencia asignada. Con BLOQUEAR espera a que se libere la ranura,
+  // primero cediendo el procesador y luego durmiendo cada vez más (hasta
+  // 1 ms); si pasa 'esperaMaxima' sobrescribe igual y los suscriptores
+  // atrasados reciben PERDIDO
+  std::uint64_t publicar(TipoCambio tipo, int id, const Pregunta *antes,
+                         const Pregunta *despues) {
+    std::uint64_t s = ultimaPublicada.load(std::memory_order_relaxed) + 1;
+    if (politica == BLOQUEAR) {
+      // La ranura de s guardaba s - capacidad: todos deben haberla leído
+      auto lleno = [&] {
+        std::uint64_t minimo = cursorMinimo();
+        return minimo != 0 && minimo + capacidad <= s;
+      };
+      auto limite = std::chrono::steady_clock::now() + esperaMaxima;
+      std::chrono::microseconds pausa(1);
+      for (int intento = 0; lleno(); ++intento) {
+        if (intento < 64) {
+          std::this_thread::yield();
+          continue;
+        }
+        auto ahora = std::chrono::steady_clock::now();
+        if (ahora >= limite) {
+          escriturasForzadas.fetch_add(1, std::memory_order_relaxed);
+          break;
+        }
+        std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(
+            pausa, limite - ahora));
+        pausa = std::min<std::chrono::microseconds>(
+            pausa * 2, std::chrono::milliseconds(1));
+      }
+    }
+
+    Ranura &ranura = ranuras[s & (capacidad - 1)];
+    ranura.secuencia.store(ESCRIBIENDO, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    ranura.tipo.store(tipo, std::memory_order_relaxed);
+    ranura.id.store(id, std::memory_order_relaxed);
+    ranura.antes.store(antes, std::memory_order_relaxed);
+    ranura.despues.store(despues, std::memory_order_relaxed);
+    ranura.secuencia.store(s, std::memory_order_release);
+    ultimaPublicada.store(s, std::memory_order_release);
+    return s;
+  }
+
+  // Método para suscribirse desde una secuencia (0 = solo eventos nuevos).
+  // Devuelve nullptr si no hay lugar o si la secuencia ya no está retenida
+  // o aún no se publicó
+  std::unique_ptr<Suscriptor> suscribir(std::uint64_t desde = 0) {
+    std::uint64_t ultima = ultimaPublicada.load(std::memory_order_acquire);
+    if (desde == 0) {
+      desde = ultima + 1;
+    } else if (desde < getSecuenciaMasAntigua() || desde > ultima + 1) {
+      return nullptr;
+    }
+    for (auto &cursor : cursores) {
+      std::uint64_t libre = 0;
+      if (cursor.compare_exchange_strong(libre, desde,
+                                         std::memory_order_acq_rel)) {
+        return std::make_unique<Suscriptor>(*this, cursor);
+      }
+    }
+    return nullptr;
+  }
+
+  // Getters
+  std::uint64_t getUltimaSecuencia() const {
+    return ultimaPublicada.load(std::memory_order_acquire);
+  }
+  std::uint64_t getSecuenciaMasAntigua() const {
+    std::uint64_t ultima = getUltimaSecuencia();
+    return ultima >= capacidad ? ultima - capacidad + 1 : 1;
+  }
+  std::size_t getCapacidad() const { return capacidad; }
+  std::uint64_t getEscriturasForzadas() const {
+    return escriturasForzadas.load(std::memory_order_relaxed);
+  }
+};
+
+// Cursor estable para recorrer el banco por páginas. Guarda el último ID
+// entregado, por lo que sigue siendo válido aunque se agreguen o eliminen
+// preguntas entre una página y la siguiente.
+struct CursorPreguntas {
+  int ultimoId = 0; // ID de la última pregunta entregada (0 = inicio)
+};
+
+// Versión inmutable de una pregunta en un instante dado. Una versión sin
+// pregunta (nullptr) indica que la pregunta fue eliminada en ese instante.
+// La secuencia es la del evento publicado en el flujo de cambios: ordena
+// todas las versiones del banco sin depender del reloj.
+struct VersionPregunta {
+  std::chrono::system_clock::time_point fecha; // Momento del cambio
+  std::uint64_t secuencia;                     // Número de cambio del banco
+  std::shared_ptr<const Pregunta> pregunta;    // Estado desde ese momento
+};
+
+// Parámetros IRT (modelo logístico de dos parámetros) de una pregunta
+struct ParametrosIRT {
+  double discriminacion;
+  double dificultad;
+};
+
+// Gestor de Preguntas - Maneja la colección de preguntas y operaciones CRUD
+class GestorPreguntas {
+private:
+  using PreguntaCompartida = std::shared_ptr<const Pregunta>;
+
+  // Versión actual de cada pregunta (ordenadas por ID). Es la misma que
+  // guarda el historial: un cambio no copia las preguntas que no toca
+  std::vector<PreguntaCompartida> preguntas;
+  int siguienteId = 1; // ID para la siguiente pregunta
+
+  // Índice para validación de preguntas repetidas: hash del texto guardado
+  // (comprimido en modo comprimido) -> IDs. No guarda copias de los textos;
+  // los choques de hash se resuelven comparando los bytes guardados
+  std::unordered_multimap<std::size_t, int> idsPorHashTexto;
+
+  // Historial de versiones por ID. Las versiones son inmutables y comparten
+  // el texto y las listas de opciones/elementos que no cambiaron entre una y
+  // otra
+  std::map<int, std::vector<VersionPregunta>> historial;
+  // Fecha del último cambio. El reloj del sistema puede retroceder (ajustes
+  // de hora); las fechas del historial no, así se pueden buscar por fecha
+  std::chrono::system_clock::time_point ultimaFecha{};
+
+  // Operación reversible: estado de cada pregunta afectada antes y después
+  // del cambio. Casi siempre es una sola; asignar temas o parámetros IRT
+  // cambia varias
+  struct Operacion {
+    struct Cambio {
+      int id;
+      std::shared_ptr<const Pregunta> anterior;  // nullptr si no existía
+      std::shared_ptr<const Pregunta> posterior; // nullptr si fue eliminada
+    };
+    std::vector<Cambio> cambios;
+  };
+  std::vector<Operacion> pilaDeshacer; // Operaciones aplicadas
+  std::vector<Operacion> pilaRehacer;  // Operaciones deshechas
+
+  CacheConsultas cache;        // Resultados de búsquedas recientes
+  MotorEscaneoParalelo motor; // Escaneos en paralelo para bancos grandes
+  FlujoCambios flujo;         // Eventos de alta, modificación y baja
+  std::shared_ptr<AlmacenTextos> almacen; // Textos comprimidos (opcional)
+
+  // Método para obtener el texto de una pregunta en la forma en que lo
+  // guarda el banco. Si la pregunta ya usa el almacén del banco no se copia
+  std::string_view textoGuardado(const Pregunta &pregunta,
+                                 std::string &buffer) const {
+    if (pregunta.getAlmacenTextos() == almacen) {
+      return pregunta.getTextoGuardado();
+    }
+    buffer = almacen ? almacen->comprimir(pregunta.getTexto())
+                     : pregunta.getTexto();
+    return buffer;
+  }
+
+  // Verifica si una pregunta es similar a otra existente. Antes también se
+  // buscaba el texto en el mismo año y en el anterior, pero cualquier texto
+  // igual ya cuenta como repetido, así que basta con el índice por hash
+  bool esPreguntaSimilar(const Pregunta &pregunta) {
+    std::string buffer;
+    std::string_view guardado = textoGuardado(pregunta, buffer);
+    auto [desde, hasta] =
+        idsPorHashTexto.equal_range(std::hash<std::string_view>{}(guardado));
+    for (auto it = desde; it != hasta; ++it) {
+      auto pos = buscarPosicion(it->second);
+      if (pos != preguntas.end() && (*pos)->getId() == it->second &&
+          (*pos)->getTextoGuardado() == guardado) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Registra una pregunta en el índice de validación
+  void registrarEnValidacion(const Pregunta &pregunta) {
+    std::string buffer;
+    idsPorHashTexto.emplace(
+        std::hash<std::string_view>{}(textoGuardado(pregunta, buffer)),
+        pregunta.getId());
+  }
+
+  // Elimina una pregunta del índice de validación
+  void quitarDeValidacion(const Pregunta &pregunta) {
+    std::string buffer;
+    auto [desde, hasta] = idsPorHashTexto.equal_range(
+        std::hash<std::string_view>{}(textoGuardado(pregunta, buffer)));
+    for (auto it = desde; it != hasta; ++it) {
+      if (it->second == pregunta.getId()) {
+        idsPorHashTexto.erase(it);
+        return;
+      }
+    }
+  }
+
+  // Busca la posición de una pregunta por ID (búsqueda binaria)
+  std::vector<PreguntaCompartida>::iterator buscarPosicion(int id) {
+    return std::ranges::lower_bound(
+        preguntas, id, {},
+        [](const PreguntaCompartida &p) { return p->getId(); });
+  }
+
+  // Guarda los textos de una pregunta entrante con el almacén del banco
+  void prepararTextos(Pregunta &pregunta) const {
+    if (pregunta.getAlmacenTextos() != almacen) {
+      pregunta.setAlmacenTextos(almacen);
+    }
+  }
+
+  // Deja la pregunta 'id' en el estado indicado (nullptr = eliminada) de forma
+  // atómica: si el nuevo estado es similar a otra pregunta no se modifica nada.
+  // Un estado guardado con otro almacén (una versión anterior al cambio de
+  // almacén, al deshacer o rehacer) entra como copia con el almacén actual
+  bool aplicarEstado(int id, std::shared_ptr<const Pregunta> estado) {
+    if (estado && estado->getAlmacenTextos() != almacen) {
+      auto copia = estado->clonar();
+      prepararTextos(*copia);
+      estado = std::move(copia);
+    }
+    auto it = buscarPosicion(id);
+    const Pregunta *actual =
+        (it != preguntas.end() && (*it)->getId() == id) ? it->get() : nullptr;
+
+    if (!actual && !estado) {
+      return false;
+    }
+    if (actual) {
+      quitarDeValidacion(*actual);
+    }
+    if (estado && esPreguntaSimilar(*estado)) {
+      // Volver a registrar la pregunta anterior para mantener consistencia
+      if (actual) {
+        registrarEnValidacion(*actual);
+      }
+      return false;
+    }
+
+    // Las consultas en caché que contienen la versión anterior o que deberían
+    // contener la nueva dejan de ser válidas
+    if (actual) {
+      cache.invalidar(actual->getNivelBloom(), actual->getAnio());
+    }
+    if (estado) {
+      cache.invalidar(estado->getNivelBloom(), estado->getAnio());
+    }
+
+    // La versión anterior sigue viva en el historial para el evento
+    const Pregunta *antes = actual;
+    if (!estado) {
+      preguntas.erase(it);
+    } else {
+      registrarEnValidacion(*estado);
+      if (actual) {
+        *it = estado;
+      } else {
+        preguntas.insert(it, estado);
+      }
+    }
+
+    auto &versiones = historial[id];
+    ultimaFecha = std::max(ultimaFecha, std::chrono::system_clock::now());
+    std::uint64_t secuencia = flujo.publicar(!actual   ? CAMBIO_ALTA
+                                             : !estado ? CAMBIO_BAJA
+                                                       : CAMBIO_MODIFICACION,
+                                             id, antes, estado.get());
+    versiones.push_back({ultimaFecha, secuencia, estado});
+    return true;
+  }
+
+  // Obtiene la última versión registrada de una pregunta
+  std::shared_ptr<const Pregunta> versionActual(int id) const {
+    auto it = historial.find(id);
+    return it != historial.end() ? it->second.back().pregunta : nullptr;
+  }
+
+  // Registra una operación nueva; invalida las operaciones deshechas
+  void registrarOperacion(Operacion operacion) {
+    pilaDeshacer.push_back(std::move(operacion));
+    pilaRehacer.clear();
+  }
+  void registrarOperacion(int id, std::shared_ptr<const Pregunta> anterior,
+                          std::shared_ptr<const Pregunta> posterior) {
+    registrarOperacion(
+        Operacion{{{id, std::move(anterior), std::move(posterior)}}});
+  }
+
+  // Deja las preguntas de una operación en su estado anterior (al deshacer,
+  // en orden inverso) o posterior. Si un estado choca con otra pregunta se
+  // revierten los ya aplicados y la operación no cambia nada
+  bool aplicarOperacion(const Operacion &op, bool deshaciendo) {
+    std::size_t n = op.cambios.size();
+    auto cambio = [&](std::size_t k) -> const Operacion::Cambio & {
+      return op.cambios[deshaciendo ? n - 1 - k : k];
+    };
+    for (std::size_t k = 0; k < n; ++k) {
+      const auto &c = cambio(k);
+      if (!aplicarEstado(c.id, deshaciendo ? c.anterior : c.posterior)) {
+        for (std::size_t j = k; j-- > 0;) {
+          const auto &hecho = cambio(j);
+          aplicarEstado(hecho.id,
+                        deshaciendo ? hecho.posterior : hecho.anterior);
+        }
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Aplica 'asignar' a una copia de cada pregunta (pares ID, valor) y
+  // registra todas las que cambiaron como una sola operación. 'asignar'
+  // devuelve false si el valor no cambia la pregunta
+  template <typename Valor, typename Asignar>
+  int asignarEnLote(const std::vector<std::pair<int, Valor>> &asignaciones,
+                    Asignar asignar) {
+    Operacion op;
+    for (const auto &[id, valor] : asignaciones) {
+      auto anterior = versionActual(id);
+      if (!anterior) {
+        continue; // Eliminada o inexistente
+      }
+      auto copia = anterior->clonar();
+      if (!asignar(*copia, valor)) {
+        continue;
+      }
+      std::shared_ptr<const Pregunta> estado = std::move(copia);
+      if (aplicarEstado(id, estado)) {
+        op.cambios.push_back({id, std::move(anterior), std::move(estado)});
+      }
+    }
+    int cambiadas = static_cast<int>(op.cambios.size());
+    if (cambiadas > 0) {
+      registrarOperacion(std::move(op));
+    }
+    return cambiadas;
+  }
+
+public:
+  // Constructor - Configura el buffer del flujo de cambios
+  explicit GestorPreguntas(
+      std::size_t capacidadFlujo = 4096,
+      FlujoCambios::PoliticaLlenado politica = FlujoCambios::SOBRESCRIBIR)
+      : flujo(capacidadFlujo, politica) {}
+
+  // Método para suscribirse a los cambios del banco desde una secuencia
+  // (0 = solo cambios nuevos)
+  std::unique_ptr<FlujoCambios::Suscriptor>
+  suscribirCambios(std::uint64_t desde = 0) {
+    return flujo.suscribir(desde);
+  }
+
+  // Método para obtener la secuencia del último cambio publicado
+  std::uint64_t getSecuenciaCambios() const {
+    return flujo.getUltimaSecuencia();
+  }
+
+  // Método para activar el modo de textos comprimidos (nullptr lo desactiva).
+  // Solo se puede cambiar con el banco vacío; desde entonces cada pregunta
+  // que entra se guarda con el almacén, también en el historial, incluso las
+  // versiones anteriores que vuelven al deshacer o rehacer
+  bool setAlmacenTextos(std::shared_ptr<AlmacenTextos> nuevo) {
+    if (!preguntas.empty()) {
+      return false;
+    }
+    almacen = std::move(nuevo);
+    return true;
+  }
+  const std::shared_ptr<AlmacenTextos> &getAlmacenTextos() const {
+    return almacen;
+  }
+
+  // Método para agregar una pregunta con validación
+  int agregarPregunta(std::unique_ptr<Pregunta> pregunta) {
+    // Validar si la pregunta es similar a otra existente
+    if (esPreguntaSimilar(*pregunta)) {
+      return -1; // Indica que la pregunta es similar a otra existente
+    }
+
+    // Asignar un nuevo ID y agregar la pregunta
+    int id = siguienteId++;
+    pregunta->setId(id);
+    prepararTextos(*pregunta);
+
+    std::shared_ptr<const Pregunta> estado = std::move(pregunta);
+    aplicarEstado(id, estado);
+    registrarOperacion(id, nullptr, estado);
+    return id;
+  }
+
+  // Método para incorporar una pregunta que ya tiene ID (por ejemplo, leída
+  // de un archivo). La carga no se registra como operación deshacible
+  bool cargarPregunta(std::unique_ptr<Pregunta> pregunta) {
+    int id = pregunta->getId();
+    if (id <= 0 || getPregunta(id)) {
+      return false;
+    }
+    prepararTextos(*pregunta);
+    std::shared_ptr<const Pregunta> estado = std::move(pregunta);
+    if (!aplicarEstado(id, estado)) {
+      return false;
+    }
+    siguienteId = std::max(siguienteId, id + 1);
+    return true;
+  }
+
+  // Método para actualizar una pregunta existente. La actualización es
+  // atómica: si falla, la pregunta almacenada no cambia
+  bool actualizarPregunta(int id,
+                          std::unique_ptr<Pregunta> preguntaActualizada) {
+    auto anterior = versionActual(id);
+    if (!anterior || !getPregunta(id)) {
+      return false;
+    }
+
+    preguntaActualizada->setId(id);
+    prepararTextos(*preguntaActualizada);
+    std::shared_ptr<const Pregunta> estado = std::move(preguntaActualizada);
+    if (!aplicarEstado(id, estado)) {
+      return false; // La actualización falló por similitud
+    }
+    registrarOperacion(id, anterior, estado);
+    return true;
+  }
+
+  // Método para eliminar una pregunta
+  bool eliminarPregunta(int id) {
+    auto anterior = versionActual(id);
+    if (!anterior || !aplicarEstado(id, nullptr)) {
+      return false;
+    }
+    registrarOperacion(id, anterior, nullptr);
+    return true;
+  }
+
+  // Método para asignar el grupo temático de varias preguntas (pares ID,
+  // grupo) en una sola operación: cada pregunta que cambia recibe una versión
+  // nueva y un evento de modificación, y deshacer revierte todas juntas.
+  // Devuelve la cantidad de preguntas que cambiaron
+  int asignarGruposTematicos(
+      const std::vector<std::pair<int, int>> &asignaciones) {
+    return asignarEnLote(asignaciones, [](Pregunta &p, int grupo) {
+      if (p.getGrupoTematico() == grupo) {
+        return false;
+      }
+      p.setGrupoTematico(grupo);
+      return true;
+    });
+  }
+
+  // Método para asignar los parámetros IRT de varias preguntas (por ejemplo,
+  // los estimados por CalibradorIRT) en una sola operación deshacible.
+  // Devuelve la cantidad de preguntas que cambiaron
+  int asignarParametrosIRT(
+      const std::vector<std::pair<int, ParametrosIRT>> &asignaciones) {
+    return asignarEnLote(asignaciones, [](Pregunta &p, ParametrosIRT irt) {
+      if (!(irt.discriminacion > 0.0) || !std::isfinite(irt.dificultad) ||
+          (p.getDiscriminacion() == irt.discriminacion &&
+           p.getDificultad() == irt.dificultad)) {
+        return false; // Parámetros inválidos o sin cambios
+      }
+      p.setParametrosIRT(irt.discriminacion, irt.dificultad);
+      return true;
+    });
+  }
+
+  // Método para deshacer la última operación (alta, actualización o baja)
+  bool deshacer() {
+    if (pilaDeshacer.empty()) {
+      return false;
+    }
+    Operacion op = pilaDeshacer.back();
+    if (!aplicarOperacion(op, true)) {
+      return false; // El estado anterior choca con otra pregunta
+    }
+    pilaDeshacer.pop_back();
+    pilaRehacer.push_back(std::move(op));
+    return true;
+  }
+
+  // Método para rehacer la última operación deshecha
+  bool rehacer() {
+    if (pilaRehacer.empty()) {
+      return false;
+    }
+    Operacion op = pilaRehacer.back();
+    if (!aplicarOperacion(op, false)) {
+      return false;
+    }
+    pilaRehacer.pop_back();
+    pilaDeshacer.push_back(std::move(op));
+    return true;
+  }
+
+  bool puedeDeshacer() const { return !pilaDeshacer.empty(); }
+  bool puedeRehacer() const { return !pilaRehacer.empty(); }
+
+  // Método para obtener todas las versiones de una pregunta
+  const std::vector<VersionPregunta> &getHistorial(int id) const {
+    static const std::vector<VersionPregunta> vacio;
+    auto it = historial.find(id);
+    return it != historial.end() ? it->second : vacio;
+  }
+
+  // Método para obtener una pregunta tal como estaba en una fecha dada
+  // (nullptr si no existía o estaba eliminada). Los cambios hechos en el
+  // mismo instante se distinguen con getVersionEnSecuencia
+  std::shared_ptr<const Pregunta>
+  getVersionEn(int id, std::chrono::system_clock::time_point fecha) const {
+    const auto &versiones = getHistorial(id);
+    auto it = std::ranges::upper_bound(versiones, fecha, {},
+                                       &VersionPregunta::fecha);
+    return it != versiones.begin() ? std::prev(it)->pregunta : nullptr;
+  }
+
+  // Método para obtener una pregunta tal como quedó tras el cambio número
+  // 'secuencia' del banco (ver getSecuenciaCambios)
+  std::shared_ptr<const Pregunta>
+  getVersionEnSecuencia(int id, std::uint64_t secuencia) const {
+    const auto &versiones = getHistorial(id);
+    auto it = std::ranges::upper_bound(versiones, secuencia, {},
+                                       &VersionPregunta::secuencia);
+    return it != versiones.begin() ? std::prev(it)->pregunta : nullptr;
+  }
+
+  // Método para obtener el banco completo tal como estaba en una fecha dada
+  std::vector<std::shared_ptr<const Pregunta>>
+  getBancoEn(std::chrono::system_clock::time_point fecha) const {
+    std::vector<std::shared_ptr<const Pregunta>> banco;
+    for (const auto &[id, versiones] : historial) {
+      if (auto pregunta = getVersionEn(id, fecha)) {
+        banco.push_back(std::move(pregunta));
+      }
+    }
+    return banco;
+  }
+
+  // Método para obtener el banco completo tras el cambio número 'secuencia'
+  std::vector<std::shared_ptr<const Pregunta>>
+  getBancoEnSecuencia(std::uint64_t secuencia) const {
+    std::vector<std::shared_ptr<const Pregunta>> banco;
+    for (const auto &[id, versiones] : historial) {
+      if (auto pregunta = getVersionEnSecuencia(id, secuencia)) {
+        banco.push_back(std::move(pregunta));
+      }
+    }
+    return banco;
+  }
+
+  // Método para obtener una pregunta por su ID. Es de solo lectura: los
+  // cambios pasan por el gestor para quedar versionados
+  const Pregunta *getPregunta(int id) const {
+    auto it = std::ranges::lower_bound(
+        preguntas, id, {},
+        [](const PreguntaCompartida &p) { return p->getId(); });
+
+    if (it != preguntas.end() && (*it)->getId() == id) {
+      return it->get();
+    }
+    return nullptr;
+  }
+
+  // Vista perezosa de todas las preguntas (de solo lectura). No copia ni
+  // reserva memoria: cada elemento se obtiene al iterar, en orden creciente
+  // de ID.
+  auto vistaPreguntas() const {
+    return preguntas | std::views::transform(
+                           [](const PreguntaCompartida &p)
+                               -> const Pregunta & { return *p; });
+  }
+
+  // Vista perezosa de las preguntas de un nivel de Bloom
+  auto vistaPorNivelBloom(int nivel) const {
+    return vistaPreguntas() | std::views::filter([nivel](const Pregunta &p) {
+             return p.getNivelBloom() == nivel;
+           });
+  }
+
+  // Vista perezosa de las preguntas de un año
+  auto vistaPorAnio(int anio) const {
+    return vistaPreguntas() | std::views::filter([anio](const Pregunta &p) {
+             return p.getAnio() == anio;
+           });
+  }
+
+  // Vista perezosa de las preguntas de un grupo temático
+  auto vistaPorGrupoTematico(int grupo) const {
+    return vistaPreguntas() | std::views::filter([grupo](const Pregunta &p) {
+             return p.getGrupoTematico() == grupo;
+           });
+  }
+
+  // Página de hasta 'cantidad' preguntas posteriores al cursor. Las preguntas
+  // se guardan ordenadas por ID, así que la página se ubica con búsqueda
+  // binaria. El llamador avanza el cursor con el ID del último elemento leído.
+  auto paginaDesde(const CursorPreguntas &cursor, std::size_t cantidad) const {
+    auto inicio = std::ranges::upper_bound(
+        preguntas, cursor.ultimoId, {},
+        [](const PreguntaCompartida &p) { return p->getId(); });
+    return std::ranges::subrange(inicio, preguntas.end()) |
+           std::views::take(cantidad) |
+           std::views::transform([](const PreguntaCompartida &p)
+                                     -> const Pregunta & { return *p; });
+  }
+
+  // Métodos para contar sin materializar resultados
+  std::size_t getCantidadPreguntas() const { return preguntas.size(); }
+  bool estaVacio() const { return preguntas.empty(); }
+  std::size_t contarPorNivelBloom(int nivel) const {
+    return std::ranges::distance(vistaPorNivelBloom(nivel));
+  }
+  std::size_t contarPorAnio(int anio) const {
+    return std::ranges::distance(vistaPorAnio(anio));
+  }
+
+  // Método para buscar con una consulta combinada. Los resultados se guardan
+  // en caché hasta que cambie alguna pregunta que pueda afectarlos
+  std::vector<const Pregunta *> buscar(const ConsultaPreguntas &consulta) {
+    if (!consulta.esValida()) {
+      return {}; // No se guarda en caché: no puede coincidir con nada
+    }
+    if (const auto *enCache = cache.buscar(consulta)) {
+      return *enCache;
+    }
+
+    std::vector<const Pregunta *> resultado = motor.filtrar(
+        preguntas,
+        [&consulta](const PreguntaCompartida &p) {
+          return consulta.coincide(p->getNivelBloom(), p->getAnio());
+        },
+        [](const PreguntaCompartida &p) -> const Pregunta * {
+          return p.get();
+        });
+    cache.guardar(consulta, resultado);
+    return resultado;
+  }
+
+  // Método para buscar preguntas por nivel de Bloom
+  std::vector<const Pregunta *> buscarPorNivelBloom(int nivel) {
+    ConsultaPreguntas consulta;
+    consulta.nivelBloom = nivel;
+    return buscar(consulta);
+  }
+
+  // Método para buscar preguntas por año
+  std::vector<const Pregunta *> buscarPorAnio(int anio) {
+    ConsultaPreguntas consulta;
+    consulta.anio = anio;
+    return buscar(consulta);
+  }
+
+  // Método para obtener los contadores de la caché de búsquedas
+  const CacheConsultas::Estadisticas &getEstadisticasCache() const {
+    return cache.getEstadisticas();
+  }
+
+  // Método para calcular el tiempo total estimado
+  int calcularTiempoTotal() {
+    return motor.reducir(
+        preguntas, 0,
+        [](const PreguntaCompartida &p) {
+          return p->getTiempoEstimado();
+        },
+        std::plus<int>());
+  }
+
+  // Método para obtener todas las preguntas (materializa la vista)
+  std::vector<const Pregunta *> getTodasLasPreguntas() const {
+    std::vector<const Pregunta *> resultado;
+    resultado.reserve(preguntas.size());
+    for (const Pregunta &p : vistaPreguntas()) {
+      resultado.push_back(&p);
+    }
+    return resultado;
+  }
+};
+
+// Archivo de Banco - Lee y escribe bancos de preguntas en archivos de texto.
+// Cada pregunta ocupa una línea con campos separados por tabuladores; los
+// tabuladores, saltos de línea y barras invertidas del texto se escapan.
+// Las líneas que empiezan con '#' son comentarios.
+class ArchivoBanco {
+public:
+  // Utilidades del formato de texto, compartidas con ArchivoRespuestas
+  static std::string escapar(std::string_view texto) {
+    std::string resultado;
+    for (char c : texto) {
+      switch (c) {
+      case '\\':
+        resultado += "\\\\";
+        break;
+      case '\t':
+        resultado += "\\t";
+        break;
+      case '\n':
+        resultado += "\\n";
+        break;
+      case '\r':
+        resultado += "\\r";
+        break;
+      default:
+        resultado += c;
+      }
+    }
+    return resultado;
+  }
+
+  static std::string desescapar(const std::string &texto) {
+    std::string resultado;
+    for (std::size_t i = 0; i < texto.size(); ++i) {
+      if (texto[i] != '\\' || i + 1 == texto.size()) {
+        resultado += texto[i];
+        continue;
+      }
+      char c = texto[++i];
+      resultado += c == 't' ? '\t' : c == 'n' ? '\n' : c == 'r' ? '\r' : c;
+    }
+    return resultado;
+  }
+
+  static std::vector<std::string> separarCampos(const std::string &linea) {
+    std::vector<std::string> campos;
+    std::size_t inicio = 0;
+    while (true) {
+      std::size_t fin = linea.find('\t', inicio);
+      campos.push_back(desescapar(linea.substr(inicio, fin - inicio)));
+      if (fin == std::string::npos) {
+        return campos;
+      }
+      inicio = fin + 1;
+    }
+  }
+
+  template <typename Numero>
+  static bool leerNumero(const std::string &campo, Numero &valor) {
+    auto [fin, error] =
+        std::from_chars(campo.data(), campo.data() + campo.size(), valor);
+    return error == std::errc() && fin == campo.data() + campo.size();
+  }
+
+public:
+  static constexpr const char *ENCABEZADO = "#BANCO_PREGUNTAS 1";
+
+  // Método para convertir una pregunta en una línea del archivo
+  static std::string serializar(const Pregunta &p) {
+    std::ostringstream salida;
+    salida.precision(17);
+    std::string tipo = p.getTipo() == "Opción Múltiple"   ? "OM"
+                       : p.getTipo() == "Verdadero/Falso" ? "VF"
+                       : p.getTipo() == "Emparejamiento"  ? "EM"
+                                                          : "BASE";
+    salida << p.getId() << '\t' << tipo << '\t' << p.getNivelBloom() << '\t'
+           << p.getTiempoEstimado() << '\t' << p.getAnio() << '\t'
+           << p.getDiscriminacion() << '\t' << p.getDificultad() << '\t'
+           << p.getGrupoTematico() << '\t' << escapar(p.getTexto());
+
+    if (auto *pom = dynamic_cast<const PreguntaOpcionMultiple *>(&p)) {
+      salida << '\t' << pom->getOpcionCorrecta() << '\t'
+             << pom->getOpciones().size();
+      for (std::string_view opcion : pom->getOpciones()) {
+        salida << '\t' << escapar(opcion);
+      }
+    } else if (auto *pvf = dynamic_cast<const PreguntaVerdaderoFalso *>(&p)) {
+      salida << '\t' << (pvf->getRespuestaCorrecta() ? 1 : 0);
+    } else if (auto *pe = dynamic_cast<const PreguntaEmparejamiento *>(&p)) {
+      salida << '\t' << pe->getElementosIzquierda().size() << '\t'
+             << pe->getElementosDerecha().size();
+      for (std::string_view elemento : pe->getElementosIzquierda()) {
+        salida << '\t' << escapar(elemento);
+      }
+      for (std::string_view elemento : pe->getElementosDerecha()) {
+        salida << '\t' << escapar(elemento);
+      }
+      for (int emparejamiento : pe->getEmparejamientosCorrectos()) {
+        salida << '\t' << emparejamiento;
+      }
+    }
+    return salida.str();
+  }
+
+  // Método para reconstruir una pregunta desde una línea (nullptr si la
+  // línea no es válida). Todos los campos se validan antes de construir la
+  // pregunta: un archivo o delta corrupto no puede dejar índices fuera de
+  // rango en el banco
+  static std::unique_ptr<Pregunta> deserializar(const std::string &linea) {
+    std::vector<std::string> c = separarCampos(linea);
+    int id, nivel, tiempo, anio, grupo;
+    double discriminacion, dificultad;
+    if (c.size() < 9 || !leerNumero(c[0], id) || !leerNumero(c[2], nivel) ||
+        !leerNumero(c[3], tiempo) || !leerNumero(c[4], anio) ||
+        !leerNumero(c[5], discriminacion) || !leerNumero(c[6], dificultad) ||
+        !leerNumero(c[7], grupo) || id <= 0 || nivel < RECORDAR ||
+        nivel > CREAR || tiempo < 0 || !std::isfinite(discriminacion) ||
+        !std::isfinite(dificultad)) {
+      return nullptr;
+    }
+    // Los largos de las listas se comparan con la cantidad de campos antes
+    // de sumarlos, así la suma no puede desbordarse
+    std::size_t restantes = c.size() - 9;
+    const std::string &tipo = c[1];
+    const std::string &texto = c[8];
+    std::unique_ptr<Pregunta> pregunta;
+
+    if (tipo == "OM") {
+      int correcta;
+      std::size_t n;
+      if (c.size() < 11 || !leerNumero(c[9], correcta) ||
+          !leerNumero(c[10], n) || n > restantes || c.size() != 11 + n ||
+          correcta < 0 || static_cast<std::size_t>(correcta) >= n) {
+        return nullptr;
+      }
+      std::vector<std::string> opciones(c.begin() + 11, c.end());
+      pregunta = std::make_unique<PreguntaOpcionMultiple>(
+          id, texto, nivel, tiempo, opciones, correcta, anio);
+    } else if (tipo == "VF") {
+      int respuesta;
+      if (c.size() != 10 || !leerNumero(c[9], respuesta) ||
+          (respuesta != 0 && respuesta != 1)) {
+        return nullptr;
+      }
+      pregunta = std::make_unique<PreguntaVerdaderoFalso>(
+          id, texto, nivel, tiempo, respuesta == 1, anio);
+    } else if (tipo == "EM") {
+      std::size_t nIzquierda, nDerecha;
+      if (c.size() < 11 || !leerNumero(c[9], nIzquierda) ||
+          !leerNumero(c[10], nDerecha) || nIzquierda > restantes ||
+          nDerecha > restantes ||
+          c.size() != 11 + 2 * nIzquierda + nDerecha) {
+        return nullptr;
+      }
+      auto inicio = c.begin() + 11;
+      std::vector<std::string> izquierda(inicio, inicio + nIzquierda);
+      std::vector<std::string> derecha(inicio + nIzquierda,
+                                       inicio + nIzquierda + nDerecha);
+      std::vector<int> emparejamientos;
+      for (auto it = inicio + nIzquierda + nDerecha; it != c.end(); ++it) {
+        int valor;
+        if (!leerNumero(*it, valor) || valor < 0 ||
+            static_cast<std::size_t>(valor) >= nDerecha) {
+          return nullptr;
+        }
+        emparejamientos.push_back(valor);
+      }
+      pregunta = std::make_unique<PreguntaEmparejamiento>(
+          id, texto, nivel, tiempo, izquierda, derecha, emparejamientos, anio);
+    } else if (tipo == "BASE" && c.size() == 9) {
+      pregunta = std::make_unique<Pregunta>(id, texto, nivel, tiempo, anio);
+    } else {
+      return nullptr;
+    }
+
+    pregunta->setParametrosIRT(discriminacion, dificultad);
+    pregunta->setGrupoTematico(grupo);
+    return pregunta;
+  }
+
+  // Método para leer las líneas de un archivo agrupadas por ID de pregunta.
+  // Devuelve false si el archivo no se puede abrir o tiene líneas inválidas
+  static bool leerRegistros(const std::string &ruta,
+                            std::map<int, std::string> &registros) {
+    std::ifstream entrada(ruta);
+    if (!entrada) {
+      return false;
+    }
+    std::string linea;
+    while (std::getline(entrada, linea)) {
+      if (linea.empty() || linea[0] == '#') {
+        continue;
+      }
+      int id;
+      if (!leerNumero(linea.substr(0, linea.find('\t')), id)) {
+        return false;
+      }
+      registros[id] = linea;
+    }
+    return true;
+  }
+
+  // Método para escribir registros (ID -> línea) en un archivo
+  static bool escribirRegistros(const std::string &ruta,
+                                const std::map<int, std::string> &registros) {
+    std::ofstream salida(ruta);
+    if (!salida) {
+      return false;
+    }
+    salida << ENCABEZADO << "\n";
+    for (const auto &[id, linea] : registros) {
+      salida << linea << "\n";
+    }
+    return static_cast<bool>(salida);
+  }
+
+  // Método para guardar todo el banco en un archivo
+  static bool guardar(const std::string &ruta, const GestorPreguntas &gestor) {
+    std::ofstream salida(ruta);
+    if (!salida) {
+      return false;
+    }
+    salida << ENCABEZADO << "\n";
+    for (const Pregunta &p : gestor.vistaPreguntas()) {
+      salida << serializar(p) << "\n";
+    }
+    return static_cast<bool>(salida);
+  }
+
+  // Método para cargar un archivo en el banco conservando los IDs. Devuelve
+  // la cantidad de preguntas cargadas o -1 si el archivo no se pudo leer;
+  // las preguntas inválidas o repetidas se omiten
+  static int cargar(const std::string &ruta, GestorPreguntas &gestor) {
+    std::map<int, std::string> registros;
+    if (!leerRegistros(ruta, registros)) {
+      return -1;
+    }
+    int cargadas = 0;
+    for (const auto &[id, linea] : registros) {
+      auto pregunta = deserializar(linea);
+      if (pregunta && gestor.cargarPregunta(std::move(pregunta))) {
+        cargadas++;
+      }
+    }
+    return cargadas;
+  }
+};
+
+// Árbol de Merkle sobre los registros de un banco. Las hojas agrupan los IDs
+// en cubetas fijas de 64 IDs y cada nodo interno resume 16 hijos, de modo
+// que dos árboles de bancos distintos tienen la misma forma y se comparan
+// nodo a nodo: solo se desciende por los subárboles cuyo hash difiere, así
+// que el costo crece con la cantidad de cambios y no con el tamaño del banco.
+// La comparación sirve para cualquier fuente con la misma forma: un árbol en
+// memoria o el índice guardado junto a un banco (SincronizadorBancos).
+class ArbolMerkle {
+public:
+  static constexpr int BITS_HOJA = 6; // 64 IDs por hoja
+  static constexpr int BITS_NODO = 4; // 16 hijos por nodo
+  static constexpr int NIVELES = 8;   // Suficiente para IDs de 32 bits
+
+  // Nodo (o registro, con la clave = ID) y su hash
+  struct Nodo {
+    std::uint64_t clave;
+    std::uint64_t hash;
+  };
+
+private:
+  std::map<int, std::uint64_t> hashPorId; // Hash del contenido de cada ID
+  std::array<std::map<std::uint64_t, std::uint64_t>, NIVELES + 1>
+      niveles; // niveles[0] = hojas, niveles[NIVELES] = raíz
+
+  static std::uint64_t combinar(std::uint64_t h, std::uint64_t valor) {
+    // Mezcla tipo FNV-1a de 64 bits aplicada a palabras completas
+    h ^= valor;
+    h *= 1099511628211ULL;
+    return h ^ (h >> 29);
+  }
+
+  // Hoja que contiene un ID
+  static std::uint64_t hojaDe(int id) {
+    return static_cast<std::uint64_t>(static_cast<std::uint32_t>(id)) >>
+           BITS_HOJA;
+  }
+
+  // Construye los niveles a partir de los hashes por ID. Los IDs se
+  // recorren en orden, así que cada hoja y cada nodo combina a sus hijos
+  // siempre en el mismo orden
+  void construirNiveles() {
+    for (const auto &[id, hash] : hashPorId) {
+      auto &h = niveles[0][hojaDe(id)];
+      h = combinar(combinar(h, static_cast<std::uint32_t>(id)), hash);
+    }
+    for (int nivel = 1; nivel <= NIVELES; ++nivel) {
+      for (const auto &[clave, hash] : niveles[nivel - 1]) {
+        auto &h = niveles[nivel][clave >> BITS_NODO];
+        h = combinar(combinar(h, clave), hash);
+      }
+    }
+  }
+
+  // Compara los nodos de un rango de claves de un nivel (nivel -1 = los
+  // registros) y desciende por los que difieren. Devuelve false si alguna
+  // fuente no se pudo leer
+  template <typename FuenteA, typename FuenteB>
+  static bool compararRango(FuenteA &a, FuenteB &b, int nivel,
+                            std::uint64_t primero, std::uint64_t ultimo,
+                            std::vector<int> &diferencias) {
+    std::vector<Nodo> nodosA, nodosB;
+    bool leidos = nivel < 0 ? a.leerRegistros(primero, ultimo, nodosA) &&
+                                  b.leerRegistros(primero, ultimo, nodosB)
+                            : a.leerNodos(nivel, primero, ultimo, nodosA) &&
+                                  b.leerNodos(nivel, primero, ultimo, nodosB);
+    if (!leidos) {
+      return false;
+    }
+    // Mezcla de las dos listas ordenadas por clave; una clave ausente en
+    // una de ellas tiene hash 0
+    std::size_t i = 0, j = 0;
+    while (i < nodosA.size() || j < nodosB.size()) {
+      std::uint64_t clave, hashA = 0, hashB = 0;
+      if (j == nodosB.size() ||
+          (i < nodosA.size() && nodosA[i].clave < nodosB[j].clave)) {
+        clave = nodosA[i].clave;
+        hashA = nodosA[i++].hash;
+      } else if (i == nodosA.size() || nodosB[j].clave < nodosA[i].clave) {
+        clave = nodosB[j].clave;
+        hashB = nodosB[j++].hash;
+      } else {
+        clave = nodosA[i].clave;
+        hashA = nodosA[i++].hash;
+        hashB = nodosB[j++].hash;
+      }
+      if (hashA == hashB) {
+        continue;
+      }
+      int bits = nivel == 0 ? BITS_HOJA : BITS_NODO;
+      if (nivel < 0) {
+        diferencias.push_back(static_cast<int>(clave));
+      } else if (!compararRango(a, b, nivel - 1, clave << bits,
+                                ((clave + 1) << bits) - 1, diferencias)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+public:
+  // Hash del contenido de un registro (FNV-1a de 64 bits)
+  static std::uint64_t hashRegistro(const std::string &registro) {
+    std::uint64_t h = 14695981039346656037ULL;
+    for (unsigned char c : registro) {
+      h ^= c;
+      h *= 1099511628211ULL;
+    }
+    return h == 0 ? 1 : h; // 0 se reserva para "registro inexistente"
+  }
+
+  // Constructor - Construye el árbol a partir de los registros (ID -> línea)
+  explicit ArbolMerkle(const std::map<int, std::string> &registros) {
+    for (const auto &[id, linea] : registros) {
+      hashPorId[id] = hashRegistro(linea);
+    }
+    construirNiveles();
+  }
+
+  // Constructor - Construye el árbol a partir de los hashes ya calculados
+  // (por ejemplo, al guardar el índice de un banco)
+  explicit ArbolMerkle(std::map<int, std::uint64_t> hashes)
+      : hashPorId(std::move(hashes)) {
+    construirNiveles();
+  }
+
+  // Métodos de lectura por rangos de claves, los mismos que ofrece el índice
+  // guardado de un banco
+  bool leerNodos(int nivel, std::uint64_t primero, std::uint64_t ultimo,
+                 std::vector<Nodo> &nodos) const {
+    const auto &mapa = niveles[nivel];
+    for (auto it = mapa.lower_bound(primero);
+         it != mapa.end() && it->first <= ultimo; ++it) {
+      nodos.push_back({it->first, it->second});
+    }
+    return true;
+  }
+  bool leerRegistros(std::uint64_t primero, std::uint64_t ultimo,
+                     std::vector<Nodo> &registros) const {
+    for (auto it = hashPorId.lower_bound(static_cast<int>(primero));
+         it != hashPorId.end() &&
+         static_cast<std::uint64_t>(it->first) <= ultimo;
+         ++it) {
+      registros.push_back({static_cast<std::uint64_t>(it->first), it->second});
+    }
+    return true;
+  }
+
+  // Método para obtener los IDs agregados, eliminados o modificados entre
+  // dos fuentes (árboles o índices guardados), en orden creciente. Devuelve
+  // false si alguna fuente no se pudo leer
+  template <typename FuenteA, typename FuenteB>
+  static bool diferencias(FuenteA &a, FuenteB &b,
+                          std::vector<int> &resultado) {
+    return compararRango(a, b, NIVELES, 0, 0, resultado);
+  }
+  static std::vector<int> diferencias(const ArbolMerkle &a,
+                                      const ArbolMerkle &b) {
+    std::vector<int> resultado;
+    diferencias(a, b, resultado);
+    return resultado;
+  }
+
+  // Método para obtener el hash de un ID (0 si no existe)
+  std::uint64_t getHash(int id) const {
+    auto it = hashPorId.find(id);
+    return it != hashPorId.end() ? it->second : 0;
+  }
+
+  std::uint64_t getHashRaiz() const {
+    auto it = niveles[NIVELES].find(0);
+    return it != niveles[NIVELES].end() ? it->second : 0;
+  }
+
+  // Método para obtener los nodos de un nivel (para guardarlos)
+  const std::map<std::uint64_t, std::uint64_t> &getNivel(int nivel) const {
+    return niveles[nivel];
+  }
+};
+
+// Sincronizador de Bancos - Calcula y aplica deltas entre archivos de banco.
+// Un delta dice, por cada pregunta cambiada, el hash que tenía en el banco
+// de origen, el hash que tiene en el banco editado y la línea nueva. Al
+// aplicarlo sobre otra copia, si la pregunta de esa copia no coincide con
+// ninguno de los dos hashes es porque ambos lados la editaron: es un
+// conflicto y esa pregunta no se modifica. Junto a cada archivo de banco se
+// guarda un índice (<banco>.merkle) con los nodos del árbol de Merkle y el
+// hash y la posición de cada registro. Mientras el banco no cambie (mismo
+// tamaño y fecha), calcular un delta desciende por los dos índices desde la
+// raíz sin cargarlos ni leer los bancos, y del banco editado solo se leen
+// las líneas que cambiaron.
+class SincronizadorBancos {
+public:
+  // Cambio de una pregunta
+  struct Cambio {
+    int id;
+    std::uint64_t hashAnterior; // 0 = la pregunta no existía (alta)
+    std::uint64_t hashNuevo;    // 0 = la pregunta fue eliminada (baja)
+    std::string registro;       // Línea nueva (vacía en una baja)
+  };
+
+  // Resultado de aplicar un delta
+  struct Resultado {
+    int aplicados = 0;
+    int yaPresentes = 0;         // El destino ya tenía el cambio
+    std::vector<int> conflictos; // IDs editados en ambos lados
+  };
+
+  static constexpr const char *ENCABEZADO_DELTA = "#DELTA_BANCO 1";
+
+  // Entrada del índice de un banco: hash del registro y posición (en bytes)
+  // de su línea dentro del archivo
+  struct EntradaIndice {
+    std::uint64_t hash;
+    std::uint64_t posicion;
+  };
+  using IndiceBanco = std::map<int, EntradaIndice>;
+
+  // Índice guardado de un banco (<banco>.merkle). Es binario, con enteros de
+  // 64 bits en little-endian y tablas ordenadas por clave:
+  //   - encabezado "#MERKLE_BANCO 2\n";
+  //   - tamaño y fecha del banco indexado;
+  //   - cantidad de nodos de cada nivel del árbol y cantidad de registros;
+  //   - los nodos de cada nivel, desde las hojas hasta la raíz (clave, hash);
+  //   - los registros (ID, hash, posición de la línea en el banco).
+  // Se lee por rangos con búsqueda binaria sobre el archivo, sin cargarlo:
+  // comparar dos índices solo lee los nodos por los que se desciende.
+  class ArchivoIndice {
+  public:
+    static constexpr std::string_view ENCABEZADO = "#MERKLE_BANCO 2\n";
+    static constexpr std::uint64_t TAM_NODO = 16;     // Clave y hash
+    static constexpr std::uint64_t TAM_REGISTRO = 24; // ID, hash y posición
+
+    // Tamaño y fecha de modificación de un banco; identifican la versión
+    // para la que se calculó el índice
+    struct Firma {
+      std::uint64_t tamano = 0;
+      std::int64_t fecha = 0;
+    };
+
+  private:
+    std::ifstream entrada;
+    std::array<std::uint64_t, ArbolMerkle::NIVELES + 1> inicioNivel{};
+    std::array<std::uint64_t, ArbolMerkle::NIVELES + 1> cantidadNivel{};
+    std::uint64_t inicioRegistros = 0;
+    std::uint64_t cantidadRegistros = 0;
+    std::uint64_t tamanoBanco = 0;
+
+    static void escribirU64(std::ostream &salida, std::uint64_t valor) {
+      std::array<char, 8> bytes;
+      for (char &byte : bytes) {
+        byte = static_cast<char>(valor & 0xFF);
+        valor >>= 8;
+      }
+      salida.write(bytes.data(), bytes.size());
+    }
+
+    bool leerU64(std::uint64_t &valor) {
+      std::array<unsigned char, 8> bytes;
+      if (!entrada.read(reinterpret_cast<char *>(bytes.data()), bytes.size())) {
+        return false;
+      }
+      valor = 0;
+      for (int i = 7; i >= 0; --i) {
+        valor = (valor << 8) | bytes[i];
+      }
+      return true;
+    }
+
+    bool leerU64En(std::uint64_t posicion, std::uint64_t &valor) {
+      entrada.clear();
+      entrada.seekg(static_cast<std::streamoff>(posicion));
+      return leerU64(valor);
+    }
+
+    // Lee de una tabla (ordenada por su primera palabra) las entradas con
+    // clave en [primero, ultimo]: búsqueda binaria y lectura secuencial
+    template <typename Leer>
+    bool leerTabla(std::uint64_t inicio, std::uint64_t cantidad,
+                   std::uint64_t tam, std::uint64_t primero,
+                   std::uint64_t ultimo, Leer leer) {
+      std::uint64_t bajo = 0, alto = cantidad;
+      while (bajo < alto) {
+        std::uint64_t medio = bajo + (alto - bajo) / 2, clave;
+        if (!leerU64En(inicio + medio * tam, clave)) {
+          return false;
+        }
+        if (clave < primero) {
+          bajo = medio + 1;
+        } else {
+          alto = medio;
+        }
+      }
+      entrada.clear();
+      entrada.seekg(static_cast<std::streamoff>(inicio + bajo * tam));
+      for (std::uint64_t k = bajo; k < cantidad; ++k) {
+        std::uint64_t clave;
+        if (!leerU64(clave)) {
+          return false;
+        }
+        if (clave > ultimo) {
+          break;
+        }
+        if (!leer(clave)) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+  public:
+    // Método para obtener la firma de un banco. false si no existe
+    static bool firmaDe(const std::string &ruta, Firma &firma) {
+      std::error_code error;
+      firma.tamano = std::filesystem::file_size(ruta, error);
+      if (error) {
+        return false;
+      }
+      auto modificado = std::filesystem::last_write_time(ruta, error);
+      firma.fecha = modificado.time_since_epoch().count();
+      return !error;
+    }
+
+    // Método para guardar el índice de un banco (después de escribir el
+    // banco, para registrar su tamaño y fecha finales)
+    static bool guardar(const std::string &rutaBanco,
+                        const IndiceBanco &indice) {
+      Firma firma;
+      if (!firmaDe(rutaBanco, firma)) {
+        return false;
+      }
+      std::map<int, std::uint64_t> hashes;
+      for (const auto &[id, entrada] : indice) {
+        hashes.emplace_hint(hashes.end(), id, entrada.hash);
+      }
+      ArbolMerkle arbol(std::move(hashes));
+
+      std::ofstream salida(rutaIndice(rutaBanco), std::ios::binary);
+      if (!salida) {
+        return false;
+      }
+      salida << ENCABEZADO;
+      escribirU64(salida, firma.tamano);
+      escribirU64(salida, static_cast<std::uint64_t>(firma.fecha));
+      for (int nivel = 0; nivel <= ArbolMerkle::NIVELES; ++nivel) {
+        escribirU64(salida, arbol.getNivel(nivel).size());
+      }
+      escribirU64(salida, indice.size());
+      for (int nivel = 0; nivel <= ArbolMerkle::NIVELES; ++nivel) {
+        for (const auto &[clave, hash] : arbol.getNivel(nivel)) {
+          escribirU64(salida, clave);
+          escribirU64(salida, hash);
+        }
+      }
+      for (const auto &[id, entrada] : indice) {
+        escribirU64(salida, static_cast<std::uint32_t>(id));
+        escribirU64(salida, entrada.hash);
+        escribirU64(salida, entrada.posicion);
+      }
+      return static_cast<bool>(salida);
+    }
+
+    // Método para abrir el índice guardado de un banco. Devuelve false si no
+    // existe, es inválido o corresponde a otra versión del banco. Con
+    // 'verificarFecha', tampoco se acepta si se guardó en el mismo intervalo
+    // de resolución de fechas (margen de 2 s) en que se modificó el banco:
+    // una edición posterior del mismo tamaño podría conservar la fecha y el
+    // índice no lo notaría
+    bool abrir(const std::string &rutaBanco, bool verificarFecha) {
+      Firma actual;
+      std::string ruta = rutaIndice(rutaBanco);
+      std::error_code error;
+      std::uint64_t tamanoIndice = std::filesystem::file_size(ruta, error);
+      if (error || !firmaDe(rutaBanco, actual)) {
+        return false;
+      }
+      if (verificarFecha) {
+        using Duracion = std::filesystem::file_time_type::duration;
+        auto guardado = std::filesystem::last_write_time(ruta, error);
+        auto margen = std::chrono::duration_cast<Duracion>(
+            std::chrono::seconds(2));
+        if (error ||
+            guardado.time_since_epoch().count() - actual.fecha <
+                margen.count()) {
+          return false;
+        }
+      }
+      entrada = std::ifstream(ruta, std::ios::binary);
+      std::string encabezado(ENCABEZADO.size(), '\0');
+      std::uint64_t tamano, fecha;
+      if (!entrada || !entrada.read(encabezado.data(), encabezado.size()) ||
+          encabezado != ENCABEZADO || !leerU64(tamano) || !leerU64(fecha) ||
+          tamano != actual.tamano ||
+          static_cast<std::int64_t>(fecha) != actual.fecha) {
+        return false;
+      }
+      std::uint64_t posicion =
+          ENCABEZADO.size() + 8 * (ArbolMerkle::NIVELES + 4);
+      for (int nivel = 0; nivel <= ArbolMerkle::NIVELES; ++nivel) {
+        if (!leerU64(cantidadNivel[nivel]) ||
+            cantidadNivel[nivel] > tamanoIndice / TAM_NODO) {
+          return false;
+        }
+        inicioNivel[nivel] = posicion;
+        posicion += cantidadNivel[nivel] * TAM_NODO;
+      }
+      if (!leerU64(cantidadRegistros) ||
+          cantidadRegistros > tamanoIndice / TAM_REGISTRO) {
+        return false;
+      }
+      inicioRegistros = posicion;
+      tamanoBanco = tamano;
+      return posicion + cantidadRegistros * TAM_REGISTRO == tamanoIndice;
+    }
+
+    // Métodos de lectura por rangos de claves (ver ArbolMerkle::diferencias)
+    bool leerNodos(int nivel, std::uint64_t primero, std::uint64_t ultimo,
+                   std::vector<ArbolMerkle::Nodo> &nodos) {
+      return leerTabla(inicioNivel[nivel], cantidadNivel[nivel], TAM_NODO,
+                       primero, ultimo, [&](std::uint64_t clave) {
+                         std::uint64_t hash;
+                         if (!leerU64(hash)) {
+                           return false;
+                         }
+                         nodos.push_back({clave, hash});
+                         return true;
+                       });
+    }
+    bool leerRegistros(std::uint64_t primero, std::uint64_t ultimo,
+                       std::vector<ArbolMerkle::Nodo> &registros) {
+      return leerTabla(inicioRegistros, cantidadRegistros, TAM_REGISTRO,
+                       primero, ultimo, [&](std::uint64_t id) {
+                         std::uint64_t hash, posicion;
+                         if (!leerU64(hash) || !leerU64(posicion)) {
+                           return false;
+                         }
+                         registros.push_back({id, hash});
+                         return true;
+                       });
+    }
+
+    // Método para buscar la entrada de un ID. Devuelve 1 si existe, 0 si no
+    // y -1 si el índice no se pudo leer o apunta fuera del banco
+    int buscar(int id, EntradaIndice &encontrada) {
+      int resultado = 0;
+      std::uint64_t clave = static_cast<std::uint32_t>(id);
+      bool leido = leerTabla(inicioRegistros, cantidadRegistros, TAM_REGISTRO,
+                             clave, clave, [&](std::uint64_t) {
+                               resultado = 1;
+                               return leerU64(encontrada.hash) &&
+                                      leerU64(encontrada.posicion);
+                             });
+      if (!leido || (resultado == 1 && (encontrada.hash == 0 ||
+                                        encontrada.posicion >= tamanoBanco))) {
+        return -1;
+      }
+      return resultado;
+    }
+
+    std::uint64_t getCantidadRegistros() const { return cantidadRegistros; }
+  };
+
+  // Ruta del índice de un banco
+  static std::string rutaIndice(const std::string &rutaBanco) {
+    return rutaBanco + ".merkle";
+  }
+
+  // Método para guardar el índice de un banco
+  static bool guardarIndice(const std::string &rutaBanco,
+                            const IndiceBanco &indice) {
+    return ArchivoIndice::guardar(rutaBanco, indice);
+  }
+
+  // Método para recorrer un banco una vez (sin guardar sus líneas) y
+  // calcular el hash y la posición de cada registro
+  static bool indexarBanco(const std::string &rutaBanco,
+                           IndiceBanco &indice) {
+    std::ifstream entrada(rutaBanco, std::ios::binary);
+    if (!entrada) {
+      return false;
+    }
+    std::string linea;
+    std::uint64_t posicion = 0;
+    while (std::getline(entrada, linea)) {
+      std::uint64_t inicio = posicion;
+      posicion += linea.size() + 1;
+      if (linea.empty() || linea[0] == '#') {
+        continue;
+      }
+      int id;
+      if (!ArchivoBanco::leerNumero(linea.substr(0, linea.find('\t')), id) ||
+          id <= 0) {
+        return false;
+      }
+      indice[id] = {ArbolMerkle::hashRegistro(linea), inicio};
+    }
+    return true;
+  }
+
+  // Método para abrir el índice de un banco: el guardado si está al día; si
+  // no, se recorre el banco y se vuelve a guardar. Devuelve false si el
+  // banco no se puede leer o el índice no se puede guardar
+  static bool abrirIndice(const std::string &rutaBanco,
+                          ArchivoIndice &archivo) {
+    if (archivo.abrir(rutaBanco, true)) {
+      return true;
+    }
+    IndiceBanco indice;
+    return indexarBanco(rutaBanco, indice) &&
+           guardarIndice(rutaBanco, indice) && archivo.abrir(rutaBanco, false);
+  }
+
+  // Método para escribir un banco (registros ID -> línea) junto con su
+  // índice
+  static bool escribirBanco(const std::string &ruta,
+                            const std::map<int, std::string> &registros) {
+    IndiceBanco indice;
+    {
+      std::ofstream salida(ruta, std::ios::binary);
+      if (!salida) {
+        return false;
+      }
+      std::string encabezado = std::string(ArchivoBanco::ENCABEZADO) + "\n";
+      salida << encabezado;
+      std::uint64_t posicion = encabezado.size();
+      for (const auto &[id, linea] : registros) {
+        indice[id] = {ArbolMerkle::hashRegistro(linea), posicion};
+        salida << linea << "\n";
+        posicion += linea.size() + 1;
+      }
+      if (!salida) {
+        return false;
+      }
+    }
+    guardarIndice(ruta, indice);
+    return true;
+  }
+
+  // Método para calcular el delta entre dos archivos de banco usando sus
+  // índices guardados: se desciende desde la raíz por los nodos que
+  // difieren, y del banco editado solo se leen las líneas que cambiaron. Si
+  // un índice no se puede guardar (p. ej. un directorio de solo lectura),
+  // los bancos se comparan en memoria
+  static bool calcularDelta(const std::string &rutaBase,
+                            const std::string &rutaEditado,
+                            std::vector<Cambio> &delta) {
+    ArchivoIndice base, editado;
+    if (!abrirIndice(rutaBase, base) || !abrirIndice(rutaEditado, editado)) {
+      std::map<int, std::string> registrosBase, registrosEditado;
+      if (!ArchivoBanco::leerRegistros(rutaBase, registrosBase) ||
+          !ArchivoBanco::leerRegistros(rutaEditado, registrosEditado)) {
+        return false;
+      }
+      std::ranges::move(calcularDelta(registrosBase, registrosEditado),
+                        std::back_inserter(delta));
+      return true;
+    }
+    std::vector<int> ids;
+    if (!ArbolMerkle::diferencias(base, editado, ids)) {
+      return false;
+    }
+    std::ifstream banco(rutaEditado, std::ios::binary);
+    for (int id : ids) {
+      EntradaIndice anterior{0, 0}, nueva{0, 0};
+      if (base.buscar(id, anterior) < 0 || editado.buscar(id, nueva) < 0) {
+        return false;
+      }
+      std::string linea;
+      if (nueva.hash != 0) {
+        banco.clear();
+        banco.seekg(static_cast<std::streamoff>(nueva.posicion));
+        if (!std::getline(banco, linea) ||
+            ArbolMerkle::hashRegistro(linea) != nueva.hash) {
+          return false; // El índice no corresponde al contenido del banco
+        }
+      }
+      delta.push_back({id, anterior.hash, nueva.hash, std::move(linea)});
+    }
+    return true;
+  }
+
+  // Indica si el registro de un alta o modificación es una pregunta válida
+  // con el ID y el hash que declara el cambio
+  static bool registroValido(const Cambio &cambio) {
+    auto pregunta = ArchivoBanco::deserializar(cambio.registro);
+    return pregunta && pregunta->getId() == cambio.id &&
+           ArbolMerkle::hashRegistro(cambio.registro) == cambio.hashNuevo;
+  }
+
+  // Método para calcular el delta que transforma 'base' en 'editado'
+  static std::vector<Cambio>
+  calcularDelta(const std::map<int, std::string> &base,
+                const std::map<int, std::string> &editado) {
+    ArbolMerkle arbolBase(base), arbolEditado(editado);
+    std::vector<Cambio> delta;
+    for (int id : ArbolMerkle::diferencias(arbolBase, arbolEditado)) {
+      auto it = editado.find(id);
+      delta.push_back({id, arbolBase.getHash(id), arbolEditado.getHash(id),
+                       it != editado.end() ? it->second : std::string()});
+    }
+    return delta;
+  }
+
+  // Método para aplicar un delta sobre los registros de otra copia
+  static Resultado aplicarDelta(std::map<int, std::string> &destino,
+                                const std::vector<Cambio> &delta) {
+    Resultado resultado;
+    for (const Cambio &cambio : delta) {
+      auto it = destino.find(cambio.id);
+      std::uint64_t actual =
+          it != destino.end() ? ArbolMerkle::hashRegistro(it->second) : 0;
+      if (actual == cambio.hashNuevo) {
+        resultado.yaPresentes++;
+      } else if (actual != cambio.hashAnterior) {
+        resultado.conflictos.push_back(cambio.id);
+      } else {
+        if (cambio.hashNuevo == 0) {
+          destino.erase(it);
+        } else {
+          destino[cambio.id] = cambio.registro;
+        }
+        resultado.aplicados++;
+      }
+    }
+    return resultado;
+  }
+
+  // Método para guardar un delta en un archivo
+  static bool escribirDelta(const std::string &ruta,
+                            const std::vector<Cambio> &delta) {
+    std::ofstream salida(ruta);
+    if (!salida) {
+      return false;
+    }
+    salida << ENCABEZADO_DELTA << "\n";
+    for (const Cambio &cambio : delta) {
+      // El registro ya viene escapado, así que no contiene saltos de línea
+      salida << cambio.id << '\t' << cambio.hashAnterior << '\t'
+             << cambio.hashNuevo << '\t' << cambio.registro << "\n";
+    }
+    return static_cast<bool>(salida);
+  }
+
+  // Método para leer un delta desde un archivo. Devuelve false si alguna
+  // línea es inválida: un registro que ArchivoBanco::deserializar rechaza,
+  // de otro ID o que no coincide con su hash, o una baja con registro
+  static bool leerDelta(const std::string &ruta, std::vector<Cambio> &delta) {
+    std::ifstream entrada(ruta);
+    if (!entrada) {
+      return false;
+    }
+    std::string linea;
+    while (std::getline(entrada, linea)) {
+      if (linea.empty() || linea[0] == '#') {
+        continue;
+      }
+      std::istringstream campos(linea);
+      Cambio cambio;
+      if (!(campos >> cambio.id >> cambio.hashAnterior >> cambio.hashNuevo)) {
+        return false;
+      }
+      campos.get(); // Tabulador antes del registro
+      std::getline(campos, cambio.registro);
+      if (cambio.hashNuevo == 0 ? !cambio.registro.empty()
+                                : !registroValido(cambio)) {
+        return false;
+      }
+      delta.push_back(std::move(cambio));
+    }
+    return true;
+  }
+
+  // Método para ejecutar la herramienta desde la línea de comandos:
+  //   --sync-delta <base> <editado> <delta>
+  //   --sync-aplicar <destino> <delta> <salida>
+  static int ejecutar(const std::vector<std::string> &args) {
+    if (args.size() == 4 && args[0] == "--sync-delta") {
+      std::vector<Cambio> delta;
+      if (!calcularDelta(args[1], args[2], delta)) {
+        std::cout << "Error: No se pudieron leer los archivos de banco.\n";
+        return 1;
+      }
+      if (!escribirDelta(args[3], delta)) {
+        std::cout << "Error: No se pudo escribir el delta.\n";
+        return 1;
+      }
+      std::cout << "Delta generado con " << delta.size() << " cambios.\n";
+      return 0;
+    }
+    if (args.size() == 4 && args[0] == "--sync-aplicar") {
+      std::map<int, std::string> destino;
+      std::vector<Cambio> delta;
+      if (!ArchivoBanco::leerRegistros(args[1], destino) ||
+          !leerDelta(args[2], delta)) {
+        std::cout << "Error: No se pudieron leer el banco o el delta.\n";
+        return 1;
+      }
+      Resultado resultado = aplicarDelta(destino, delta);
+      if (!escribirBanco(args[3], destino)) {
+        std::cout << "Error: No se pudo escribir el banco resultante.\n";
+        return 1;
+      }
+      std::cout << "Cambios aplicados: " << resultado.aplicados
+                << ", ya presentes: " << resultado.yaPresentes
+                << ", conflictos: " << resultado.conflictos.size() << "\n";
+      for (int id : resultado.conflictos) {
+        std::cout << "  Conflicto en la pregunta ID " << id << "\n";
+      }
+      return resultado.conflictos.empty() ? 0 : 2;
+    }
+    std::cout << "Uso:\n"
+              << "  --sync-delta <base> <editado> <delta>\n"
+              << "  --sync-aplicar <destino> <delta> <salida>\n";
+    return 1;
+  }
+};
+
+// Formato columnar del banco - Archivos Parquet, que se abren directamente
+// con pandas, DuckDB, Spark o Arrow. Se escribe el subconjunto necesario:
+//   - el archivo empieza y termina con "PAR1"; al final van los metadatos
+//     (protocolo compacto de Thrift) y su largo en 4 bytes little-endian;
+//   - cada grupo de filas guarda una porción por columna, con una página de
+//     diccionario opcional y una página de datos (versión 1);
+//   - las columnas son REQUIRED, así las páginas no llevan niveles;
+//   - enteros como INT64, reales como DOUBLE y textos como BYTE_ARRAY UTF8,
+//     siempre en little-endian sin importar el equipo;
+//   - una porción con pocos valores distintos (a lo más la mitad) se
+//     codifica con diccionario (RLE_DICTIONARY); si no, PLAIN;
+//   - todas las páginas se comprimen con Snappy.
+class FormatoColumnar {
+public:
+  enum TipoColumna { COL_ENTERO = 1, COL_REAL = 2, COL_TEXTO = 3 };
+
+  struct Columna {
+    std::string nombre;
+    TipoColumna tipo;
+  };
+
+  // Valores de una columna dentro de un grupo (solo se usa el del tipo)
+  struct ValoresColumna {
+    std::vector<std::int64_t> enteros;
+    std::vector<double> reales;
+    std::vector<std::string> textos;
+
+    std::size_t cantidad(TipoColumna tipo) const {
+      return tipo == COL_ENTERO ? enteros.size()
+             : tipo == COL_REAL ? reales.size()
+                                : textos.size();
+    }
+
+    void limpiar() {
+      enteros.clear();
+      reales.clear();
+      textos.clear();
+    }
+  };
+
+  // Porción de una columna ya codificada: sus páginas, listas para escribir
+  struct PorcionColumna {
+    std::string bytes;              // Cabecera y contenido de cada página
+    bool conDiccionario = false;    // Si empieza con página de diccionario
+    std::size_t inicioDatos = 0;    // Posición de la página de datos
+    std::size_t bytesSinComprimir = 0; // Cabeceras y contenido sin comprimir
+  };
+
+  static constexpr const char *MAGIA = "PAR1";
+
+  // Constantes de Parquet que usa el banco
+  enum TipoFisico { INT64 = 2, DOUBLE = 5, BYTE_ARRAY = 6 };
+  enum Codificacion {
+    PLAIN = 0,
+    PLAIN_DICTIONARY = 2, // Nombre antiguo de RLE_DICTIONARY
+    RLE = 3,
+    RLE_DICTIONARY = 8
+  };
+  enum TipoPagina { DATA_PAGE = 0, DICTIONARY_PAGE = 2 };
+  enum Compresion { SIN_COMPRESION = 0, SNAPPY = 1 };
+  static constexpr int REQUIRED = 0; // Repetición de las columnas
+  static constexpr int UTF8 = 0;     // Tipo convertido de los textos
+
+  static TipoFisico tipoFisico(TipoColumna tipo) {
+    return tipo == COL_ENTERO ? INT64 : tipo == COL_REAL ? DOUBLE : BYTE_ARRAY;
+  }
+
+  static void escribirVarint(std::string &destino, std::uint64_t valor) {
+    while (valor >= 0x80) {
+      destino += static_cast<char>(valor | 0x80);
+      valor >>= 7;
+    }
+    destino += static_cast<char>(valor);
+  }
+
+  // Lee un varint avanzando 'pos'; devuelve false si el dato está cortado
+  static bool leerVarint(std::string_view origen, std::size_t &pos,
+                         std::uint64_t &valor) {
+    valor = 0;
+    for (int desplazamiento = 0; desplazamiento < 64; desplazamiento += 7) {
+      if (pos >= origen.size()) {
+        return false;
+      }
+      auto byte = static_cast<unsigned char>(origen[pos++]);
+      valor |= static_cast<std::uint64_t>(byte & 0x7F) << desplazamiento;
+      if (!(byte & 0x80)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Escribe los 'bytes' bytes menos significativos de 'valor' en
+  // little-endian
+  static void escribirLE(std::string &destino, std::uint64_t valor,
+                         int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+      destino += static_cast<char>(valor >> (8 * i));
+    }
+  }
+
+  static bool leerLE(std::string_view origen, std::size_t &pos, int bytes,
+                     std::uint64_t &valor) {
+    if (pos > origen.size() ||
+        origen.size() - pos < static_cast<std::size_t>(bytes)) {
+      return false;
+    }
+    valor = 0;
+    for (int i = 0; i < bytes; ++i) {
+      valor |= static_cast<std::uint64_t>(
+                   static_cast<unsigned char>(origen[pos++]))
+               << (8 * i);
+    }
+    return true;
+  }
+
+  // Escritor del protocolo compacto de Thrift, con el que Parquet codifica
+  // sus metadatos. Cada campo lleva su número y tipo; la estructura termina
+  // con un byte 0.
+  class EscritorThrift {
+  private:
+    std::string &destino;
+    std::vector<int> pila; // Último campo de cada estructura abierta
+    int ultimoCampo = 0;
+
+    static std::uint64_t zigzag(std::int64_t valor) {
+      return (static_cast<std::uint64_t>(valor) << 1) ^
+             static_cast<std::uint64_t>(valor >> 63);
+    }
+
+    void cabeceraCampo(int campo, int tipo) {
+      int delta = campo - ultimoCampo;
+      if (delta > 0 && delta <= 15) {
+        destino += static_cast<char>((delta << 4) | tipo);
+      } else {
+        destino += static_cast<char>(tipo);
+        escribirVarint(destino, zigzag(campo));
+      }
+      ultimoCampo = campo;
+    }
+
+  public:
+    enum TipoThrift {
+      T_VERDADERO = 1,
+      T_FALSO = 2,
+      T_BYTE = 3,
+      T_I16 = 4,
+      T_I32 = 5,
+      T_I64 = 6,
+      T_DOUBLE = 7,
+      T_BINARIO = 8,
+      T_LISTA = 9,
+      T_CONJUNTO = 10,
+      T_MAPA = 11,
+      T_ESTRUCTURA = 12
+    };
+
+    // Constructor - Escribe una estructura (los metadatos o una cabecera)
+    explicit EscritorThrift(std::string &destino) : destino(destino) {}
+
+    void i32(int campo, std::int32_t valor) {
+      cabeceraCampo(campo, T_I32);
+      escribirVarint(destino, zigzag(valor));
+    }
+    void i64(int campo, std::int64_t valor) {
+      cabeceraCampo(campo, T_I64);
+      escribirVarint(destino, zigzag(valor));
+    }
+    void binario(int campo, std::string_view valor) {
+      cabeceraCampo(campo, T_BINARIO);
+      elementoBinario(valor);
+    }
+
+    // Abre una estructura como campo de la actual
+    void iniciarEstructura(int campo) {
+      cabeceraCampo(campo, T_ESTRUCTURA);
+      iniciarElemento();
+    }
+    // Cierra la estructura en curso (o la principal)
+    void terminarEstructura() {
+      destino += '\0';
+      if (!pila.empty()) {
+        ultimoCampo = pila.back();
+        pila.pop_back();
+      }
+    }
+
+    // Abre una lista de 'cantidad' elementos del tipo indicado
+    void iniciarLista(int campo, int tipoElemento, std::size_t cantidad) {
+      cabeceraCampo(campo, T_LISTA);
+      if (cantidad < 15) {
+        destino += static_cast<char>((cantidad << 4) | tipoElemento);
+      } else {
+        destino += static_cast<char>(0xF0 | tipoElemento);
+        escribirVarint(destino, cantidad);
+      }
+    }
+    void elementoI32(std::int32_t valor) {
+      escribirVarint(destino, zigzag(valor));
+    }
+    void elementoBinario(std::string_view valor) {
+      escribirVarint(destino, valor.size());
+      destino.append(valor);
+    }
+    // Abre una estructura como elemento de una lista
+    void iniciarElemento() {
+      pila.push_back(ultimoCampo);
+      ultimoCampo = 0;
+    }
+  };
+
+  // Lector del protocolo compacto de Thrift. Los campos desconocidos se
+  // saltan, así se pueden leer metadatos escritos por otras herramientas
+  class LectorThrift {
+  private:
+    std::string_view origen;
+    std::size_t pos = 0;
+    std::vector<int> pila;
+    int ultimoCampo = 0;
+    bool valido = true;
+
+    static std::int64_t desZigzag(std::uint64_t valor) {
+      return static_cast<std::int64_t>(valor >> 1) ^
+             -static_cast<std::int64_t>(valor & 1);
+    }
+
+    bool leerByte(int &byte) {
+      if (pos >= origen.size()) {
+        return valido = false;
+      }
+      byte = static_cast<unsigned char>(origen[pos++]);
+      return true;
+    }
+
+  public:
+    explicit LectorThrift(std::string_view origen) : origen(origen) {}
+
+    // Método para leer la cabecera del siguiente campo de la estructura en
+    // curso. Devuelve false al llegar a su fin o si el dato está cortado
+    bool siguienteCampo(int &campo, int &tipo) {
+      int byte;
+      if (!valido || !leerByte(byte) || byte == 0) {
+        return false;
+      }
+      tipo = byte & 0x0F;
+      if (byte >> 4) {
+        campo = ultimoCampo + (byte >> 4);
+      } else {
+        campo = static_cast<int>(entero());
+      }
+      ultimoCampo = campo;
+      return valido;
+    }
+
+    // Métodos para leer valores (i16, i32 e i64 se codifican igual)
+    std::int64_t entero() {
+      std::uint64_t valor = 0;
+      if (valido && !leerVarint(origen, pos, valor)) {
+        valido = false;
+      }
+      return desZigzag(valor);
+    }
+    std::string_view binario() {
+      std::uint64_t largo = 0;
+      if (!valido || !leerVarint(origen, pos, largo) ||
+          largo > origen.size() - pos) {
+        valido = false;
+        return {};
+      }
+      std::string_view valor = origen.substr(pos, largo);
+      pos += largo;
+      return valor;
+    }
+
+    // Método para leer la cabecera de una lista; devuelve su largo
+    std::size_t lista(int &tipoElemento) {
+      int byte;
+      if (!valido || !leerByte(byte)) {
+        return 0;
+      }
+      tipoElemento = byte & 0x0F;
+      std::uint64_t cantidad = static_cast<std::uint64_t>(byte) >> 4;
+      if (cantidad == 15 && !leerVarint(origen, pos, cantidad)) {
+        valido = false;
+      }
+      // Cada elemento ocupa al menos un byte
+      if (cantidad > origen.size() - pos) {
+        valido = false;
+      }
+      return valido ? cantidad : 0;
+    }
+
+    void entrarEstructura() {
+      pila.push_back(ultimoCampo);
+      ultimoCampo = 0;
+    }
+    // Se llama después de que siguienteCampo() devolvió false
+    void salirEstructura() {
+      if (pila.empty()) {
+        valido = false;
+        return;
+      }
+      ultimoCampo = pila.back();
+      pila.pop_back();
+    }
+
+    // Método para saltar un valor del tipo indicado. 'enLista' distingue
+    // los booleanos, que en una lista ocupan un byte
+    void saltar(int tipo, bool enLista = false) {
+      if (!valido || pila.size() > 64) {
+        valido = false;
+        return;
+      }
+      int elemento, byte;
+      switch (tipo) {
+      case EscritorThrift::T_VERDADERO:
+      case EscritorThrift::T_FALSO:
+        if (enLista) {
+          leerByte(byte);
+        }
+        break;
+      case EscritorThrift::T_BYTE:
+        leerByte(byte);
+        break;
+      case EscritorThrift::T_I16:
+      case EscritorThrift::T_I32:
+      case EscritorThrift::T_I64:
+        entero();
+        break;
+      case EscritorThrift::T_DOUBLE:
+        if (origen.size() - pos < 8) {
+          valido = false;
+        } else {
+          pos += 8;
+        }
+        break;
+      case EscritorThrift::T_BINARIO:
+        binario();
+        break;
+      case EscritorThrift::T_LISTA:
+      case EscritorThrift::T_CONJUNTO:
+        for (std::size_t i = lista(elemento); valido && i > 0; --i) {
+          saltar(elemento, true);
+        }
+        break;
+      case EscritorThrift::T_MAPA: {
+        std::uint64_t cantidad = 0;
+        if (!leerVarint(origen, pos, cantidad) ||
+            cantidad > origen.size() - pos) {
+          valido = false;
+          break;
+        }
+        if (cantidad > 0 && leerByte(byte)) {
+          for (; valido && cantidad > 0; --cantidad) {
+            saltar(byte >> 4, true);
+            saltar(byte & 0x0F, true);
+          }
+        }
+        break;
+      }
+      case EscritorThrift::T_ESTRUCTURA: {
+        entrarEstructura();
+        int campo;
+        while (siguienteCampo(campo, elemento)) {
+          saltar(elemento);
+        }
+        salirEstructura();
+        break;
+      }
+      default:
+        valido = false;
+      }
+    }
+
+    bool esValido() const { return valido; }
+    std::size_t getPosicion() const { return pos; }
+  };
+
+  // Método para comprimir con Snappy (formato de bloque, sin marcos). Usa
+  // una tabla hash de secuencias de 4 bytes por cada bloque de 64 KiB, así
+  // todas las copias usan desplazamientos de 2 bytes
+  static void comprimirSnappy(std::string_view origen, std::string &destino) {
+    constexpr std::size_t BLOQUE = 1 << 16;
+    constexpr int BITS_TABLA = 14;
+    escribirVarint(destino, origen.size());
+    auto literal = [&destino](std::string_view texto) {
+      if (texto.empty()) {
+        return;
+      }
+      std::size_t n = texto.size() - 1;
+      if (n < 60) {
+        destino += static_cast<char>(n << 2);
+      } else {
+        int bytes = n < (1u << 8) ? 1 : n < (1u << 16) ? 2 : n < (1u << 24) ? 3
+                                                                           : 4;
+        destino += static_cast<char>((59 + bytes) << 2);
+        escribirLE(destino, n, bytes);
+      }
+      destino.append(texto);
+    };
+
+    std::vector<int> tabla(1 << BITS_TABLA);
+    for (std::size_t base = 0; base < origen.size(); base += BLOQUE) {
+      std::size_t fin = std::min(origen.size(), base + BLOQUE);
+      std::ranges::fill(tabla, -1);
+      std::size_t pendiente = base; // Inicio del literal aún no escrito
+      std::size_t i = base;
+      while (i + 4 <= fin) {
+        std::uint32_t cuatro;
+        std::memcpy(&cuatro, origen.data() + i, 4);
+        auto h = (cuatro * 0x1E35A7BDu) >> (32 - BITS_TABLA);
+        int candidato = tabla[h];
+        tabla[h] = static_cast<int>(i - base);
+        if (candidato < 0 ||
+            std::memcmp(origen.data() + base + candidato, origen.data() + i,
+                        4) != 0) {
+          ++i;
+          continue;
+        }
+        std::size_t desde = base + candidato;
+        std::size_t largo = 4;
+        while (i + largo < fin && origen[desde + largo] == origen[i + largo]) {
+          ++largo;
+        }
+        literal(origen.substr(pendiente, i - pendiente));
+        std::size_t desplazamiento = i - desde;
+        for (std::size_t resto = largo; resto > 0;) {
+          std::size_t parte = std::min<std::size_t>(resto, 64);
+          destino += static_cast<char>(((parte - 1) << 2) | 2);
+          escribirLE(destino, desplazamiento, 2);
+          resto -= parte;
+        }
+        i += largo;
+        pendiente = i;
+      }
+      literal(origen.substr(pendiente, fin - pendiente));
+    }
+  }
+
+  // Método para descomprimir Snappy. Devuelve false si el dato está cortado,
+  // una copia apunta fuera de lo ya descomprimido o el largo no coincide
+  static bool descomprimirSnappy(std::string_view origen,
+                                 std::string &destino) {
+    std::size_t pos = 0;
+    std::uint64_t largo;
+    if (!leerVarint(origen, pos, largo) || largo > (1ull << 32)) {
+      return false;
+    }
+    destino.clear();
+    destino.reserve(largo);
+    while (pos < origen.size()) {
+      auto etiqueta = static_cast<unsigned char>(origen[pos++]);
+      std::uint64_t n = etiqueta >> 2, desplazamiento = 0;
+      if ((etiqueta & 3) == 0) {
+        if (n >= 60 && !leerLE(origen, pos, static_cast<int>(n - 59), n)) {
+          return false;
+        }
+        if (n + 1 > origen.size() - pos || n + 1 > largo - destino.size()) {
+          return false;
+        }
+        destino.append(origen.substr(pos, n + 1));
+        pos += n + 1;
+        continue;
+      }
+      if ((etiqueta & 3) == 1) {
+        std::uint64_t bajo;
+        if (!leerLE(origen, pos, 1, bajo)) {
+          return false;
+        }
+        n = 4 + (n & 7);
+        desplazamiento = ((etiqueta >> 5) << 8) | bajo;
+      } else {
+        n += 1;
+        if (!leerLE(origen, pos, (etiqueta & 3) == 2 ? 2 : 4,
+                    desplazamiento)) {
+          return false;
+        }
+      }
+      if (desplazamiento == 0 || desplazamiento > destino.size() ||
+          n > largo - destino.size()) {
+        return false;
+      }
+      // Byte a byte: la copia puede solaparse con lo que va escribiendo
+      std::size_t desde = destino.size() - desplazamiento;
+      for (std::uint64_t k = 0; k < n; ++k) {
+        destino += destino[desde + k];
+      }
+    }
+    return destino.size() == largo;
+  }
+
+  // Método para codificar índices con el híbrido RLE / empaquetado de bits
+  // de Parquet: rachas de 8 o más valores iguales como (largo, valor) y el
+  // resto en grupos de 8 valores de 'ancho' bits
+  static void codificarIndices(const std::vector<std::uint32_t> &indices,
+                               int ancho, std::string &destino) {
+    int bytesValor = (ancho + 7) / 8;
+    std::size_t n = indices.size();
+    auto largoRacha = [&](std::size_t i) {
+      std::size_t j = i + 1;
+      while (j < n && indices[j] == indices[i]) {
+        ++j;
+      }
+      return j - i;
+    };
+    for (std::size_t i = 0; i < n;) {
+      std::size_t racha = largoRacha(i);
+      if (racha >= 8) {
+        escribirVarint(destino, racha << 1);
+        escribirLE(destino, indices[i], bytesValor);
+        i += racha;
+        continue;
+      }
+      std::size_t inicio = i, grupos = 0;
+      do {
+        i = std::min(n, i + 8);
+        ++grupos;
+      } while (i < n && largoRacha(i) < 8);
+      escribirVarint(destino, (grupos << 1) | 1);
+      std::uint64_t acumulado = 0;
+      int bits = 0;
+      for (std::size_t k = inicio; k < inicio + grupos * 8; ++k) {
+        acumulado |= static_cast<std::uint64_t>(k < n ? indices[k] : 0)
+                     << bits;
+        bits += ancho;
+        for (; bits >= 8; bits -= 8) {
+          destino += static_cast<char>(acumulado);
+          acumulado >>= 8;
+        }
+      }
+    }
+  }
+
+  static bool decodificarIndices(std::string_view origen, std::size_t &pos,
+                                 std::size_t cantidad, int ancho,
+                                 std::vector<std::uint32_t> &indices) {
+    if (ancho < 0 || ancho > 32) {
+      return false;
+    }
+    int bytesValor = (ancho + 7) / 8;
+    std::uint64_t mascara = (1ull << ancho) - 1;
+    while (indices.size() < cantidad) {
+      std::uint64_t cabecera, valor;
+      if (!leerVarint(origen, pos, cabecera)) {
+        return false;
+      }
+      if (!(cabecera & 1)) {
+        std::uint64_t racha = cabecera >> 1;
+        if (racha > cantidad - indices.size() ||
+            !leerLE(origen, pos, bytesValor, valor)) {
+          return false;
+        }
+        indices.insert(indices.end(), racha,
+                       static_cast<std::uint32_t>(valor));
+        continue;
+      }
+      // Cada grupo de 8 valores ocupa 'ancho' bytes, y solo el último
+      // grupo de la página puede venir incompleto
+      std::uint64_t grupos = cabecera >> 1;
+      if (grupos > (cantidad - indices.size() + 7) / 8 ||
+          (ancho > 0 && grupos > (origen.size() - pos) / ancho)) {
+        return false;
+      }
+      std::uint64_t acumulado = 0;
+      int bits = 0;
+      for (std::uint64_t k = 0; k < grupos * 8; ++k) {
+        for (; bits < ancho; bits += 8) {
+          acumulado |= static_cast<std::uint64_t>(
+                           static_cast<unsigned char>(origen[pos++]))
+                       << bits;
+        }
+        if (indices.size() < cantidad) {
+          indices.push_back(static_cast<std::uint32_t>(acumulado & mascara));
+        }
+        acumulado >>= ancho;
+        bits -= ancho;
+      }
+    }
+    return true;
+  }
+
+  // Métodos para escribir un valor en codificación PLAIN
+  static void plano(std::int64_t valor, std::string &destino) {
+    escribirLE(destino, static_cast<std::uint64_t>(valor), 8);
+  }
+  static void plano(double valor, std::string &destino) {
+    escribirLE(destino, std::bit_cast<std::uint64_t>(valor), 8);
+  }
+  static void plano(std::string_view valor, std::string &destino) {
+    escribirLE(destino, valor.size(), 4);
+    destino.append(valor);
+  }
+
+  // Método para leer 'cantidad' valores PLAIN; deben ocupar todo el origen
+  static bool leerPlano(TipoColumna tipo, std::string_view origen,
+                        std::size_t cantidad, ValoresColumna &valores) {
+    std::size_t pos = 0;
+    for (std::size_t i = 0; i < cantidad; ++i) {
+      std::uint64_t valor;
+      if (!leerLE(origen, pos, tipo == COL_TEXTO ? 4 : 8, valor)) {
+        return false;
+      }
+      if (tipo == COL_ENTERO) {
+        valores.enteros.push_back(static_cast<std::int64_t>(valor));
+      } else if (tipo == COL_REAL) {
+        valores.reales.push_back(std::bit_cast<double>(valor));
+      } else {
+        if (valor > origen.size() - pos) {
+          return false;
+        }
+        valores.textos.emplace_back(origen.substr(pos, valor));
+        pos += valor;
+      }
+    }
+    return pos == origen.size();
+  }
+
+private:
+  // Escribe una página: su cabecera y el contenido comprimido con Snappy
+  static void escribirPagina(TipoPagina tipo, std::size_t cantidad,
+                             Codificacion codificacion,
+                             const std::string &contenido,
+                             PorcionColumna &porcion) {
+    std::string comprimido, cabecera;
+    comprimirSnappy(contenido, comprimido);
+    EscritorThrift thrift(cabecera);
+    thrift.i32(1, tipo);
+    thrift.i32(2, static_cast<std::int32_t>(contenido.size()));
+    thrift.i32(3, static_cast<std::int32_t>(comprimido.size()));
+    thrift.iniciarEstructura(tipo == DATA_PAGE ? 5 : 7);
+    thrift.i32(1, static_cast<std::int32_t>(cantidad));
+    thrift.i32(2, codificacion);
+    if (tipo == DATA_PAGE) {
+      thrift.i32(3, RLE); // Niveles de definición (no hay)
+      thrift.i32(4, RLE); // Niveles de repetición (no hay)
+    }
+    thrift.terminarEstructura();
+    thrift.terminarEstructura();
+    porcion.bytes += cabecera;
+    porcion.bytes += comprimido;
+    porcion.bytesSinComprimir += cabecera.size() + contenido.size();
+  }
+
+  // Codifica los valores de una porción con diccionario o PLAIN. 'clave'
+  // da la clave de cada valor en el diccionario
+  template <typename Valor, typename Clave>
+  static void codificarValores(const std::vector<Valor> &valores,
+                               Clave clave, PorcionColumna &porcion) {
+    using TipoClave = std::decay_t<std::invoke_result_t<Clave, const Valor &>>;
+    std::unordered_map<TipoClave, std::uint32_t> diccionario;
+    std::vector<const Valor *> entradas;
+    std::vector<std::uint32_t> indices;
+    indices.reserve(valores.size());
+    bool conDiccionario = !valores.empty();
+    for (const Valor &valor : valores) {
+      auto [it, nuevo] = diccionario.try_emplace(
+          clave(valor), static_cast<std::uint32_t>(entradas.size()));
+      if (nuevo) {
+        entradas.push_back(&valor);
+        if (entradas.size() > valores.size() / 2 + 1) {
+          conDiccionario = false; // Casi no se repiten: no conviene
+          break;
+        }
+      }
+      indices.push_back(it->second);
+    }
+
+    std::string contenido;
+    if (conDiccionario) {
+      for (const Valor *entrada : entradas) {
+        plano(*entrada, contenido);
+      }
+      escribirPagina(DICTIONARY_PAGE, entradas.size(), PLAIN, contenido,
+                     porcion);
+      porcion.conDiccionario = true;
+      porcion.inicioDatos = porcion.bytes.size();
+      int ancho = std::max(1, static_cast<int>(std::bit_width(
+                                  entradas.size() - 1)));
+      contenido.assign(1, static_cast<char>(ancho));
+      codificarIndices(indices, ancho, contenido);
+      escribirPagina(DATA_PAGE, valores.size(), RLE_DICTIONARY, contenido,
+                     porcion);
+    } else {
+      for (const Valor &valor : valores) {
+        plano(valor, contenido);
+      }
+      escribirPagina(DATA_PAGE, valores.size(), PLAIN, contenido, porcion);
+    }
+  }
+
+public:
+  // Método para codificar la porción de una columna en un grupo
+  static void codificarColumna(TipoColumna tipo, const ValoresColumna &valores,
+                               PorcionColumna &porcion) {
+    porcion = {};
+    if (tipo == COL_ENTERO) {
+      codificarValores(valores.enteros, std::identity(), porcion);
+    } else if (tipo == COL_REAL) {
+      // Los reales se comparan por sus bits (0.0 y -0.0 son distintos)
+      codificarValores(
+          valores.reales,
+          [](double x) { return std::bit_cast<std::uint64_t>(x); }, porcion);
+    } else {
+      codificarValores(
+          valores.textos,
+          [](const std::string &x) { return std::string_view(x); }, porcion);
+    }
+  }
+
+  // Método para decodificar la porción de una columna con 'cantidad' valores
+  static bool decodificarColumna(TipoColumna tipo, std::string_view porcion,
+                                 std::size_t cantidad, int compresion,
+                                 ValoresColumna &valores) {
+    ValoresColumna diccionario;
+    bool hayDiccionario = false;
+    std::string contenido;
+    std::vector<std::uint32_t> indices;
+    std::size_t pos = 0;
+    while (valores.cantidad(tipo) < cantidad && pos < porcion.size()) {
+      LectorThrift thrift(porcion.substr(pos));
+      std::int64_t tipoPagina = -1, sinComprimir = -1, comprimido = -1;
+      std::int64_t valoresPagina = -1, codificacion = -1;
+      int campo, tipoCampo;
+      while (thrift.siguienteCampo(campo, tipoCampo)) {
+        if (campo == 1 && tipoCampo == EscritorThrift::T_I32) {
+          tipoPagina = thrift.entero();
+        } else if (campo == 2 && tipoCampo == EscritorThrift::T_I32) {
+          sinComprimir = thrift.entero();
+        } else if (campo == 3 && tipoCampo == EscritorThrift::T_I32) {
+          comprimido = thrift.entero();
+        } else if ((campo == 5 || campo == 7) &&
+                   tipoCampo == EscritorThrift::T_ESTRUCTURA) {
+          thrift.entrarEstructura();
+          while (thrift.siguienteCampo(campo, tipoCampo)) {
+            if (campo == 1 && tipoCampo == EscritorThrift::T_I32) {
+              valoresPagina = thrift.entero();
+            } else if (campo == 2 && tipoCampo == EscritorThrift::T_I32) {
+              codificacion = thrift.entero();
+            } else {
+              thrift.saltar(tipoCampo);
+            }
+          }
+          thrift.salirEstructura();
+        } else {
+          thrift.saltar(tipoCampo);
+        }
+      }
+      pos += thrift.getPosicion();
+      if (!thrift.esValido() || sinComprimir < 0 || comprimido < 0 ||
+          static_cast<std::uint64_t>(comprimido) > porcion.size() - pos) {
+        return false;
+      }
+      std::string_view datos = porcion.substr(pos, comprimido);
+      pos += comprimido;
+      if (compresion == SNAPPY) {
+        if (!descomprimirSnappy(datos, contenido)) {
+          return false;
+        }
+      } else if (compresion == SIN_COMPRESION) {
+        contenido.assign(datos);
+      } else {
+        return false;
+      }
+      if (contenido.size() != static_cast<std::uint64_t>(sinComprimir)) {
+        return false;
+      }
+
+      if (tipoPagina == DICTIONARY_PAGE) {
+        if (hayDiccionario || valoresPagina < 0 ||
+            static_cast<std::uint64_t>(valoresPagina) > contenido.size() ||
+            !leerPlano(tipo, contenido, valoresPagina, diccionario)) {
+          return false;
+        }
+        hayDiccionario = true;
+        continue;
+      }
+      if (tipoPagina != DATA_PAGE) {
+        continue; // Otras páginas (índices) no llevan valores
+      }
+      if (valoresPagina < 0 || static_cast<std::uint64_t>(valoresPagina) >
+                                   cantidad - valores.cantidad(tipo)) {
+        return false;
+      }
+      if (codificacion == PLAIN) {
+        if (!leerPlano(tipo, contenido, valoresPagina, valores)) {
+          return false;
+        }
+        continue;
+      }
+      if ((codificacion != RLE_DICTIONARY &&
+           codificacion != PLAIN_DICTIONARY) ||
+          !hayDiccionario || contenido.empty()) {
+        return false;
+      }
+      std::size_t posIndices = 1;
+      indices.clear();
+      if (!decodificarIndices(contenido, posIndices, valoresPagina,
+                              static_cast<unsigned char>(contenido[0]),
+                              indices)) {
+        return false;
+      }
+      std::size_t entradas = diccionario.cantidad(tipo);
+      for (std::uint32_t indice : indices) {
+        if (indice >= entradas) {
+          return false;
+        }
+        if (tipo == COL_ENTERO) {
+          valores.enteros.push_back(diccionario.enteros[indice]);
+        } else if (tipo == COL_REAL) {
+          valores.reales.push_back(diccionario.reales[indice]);
+        } else {
+          valores.textos.push_back(diccionario.textos[indice]);
+        }
+      }
+    }
+    return valores.cantidad(tipo) == cantidad;
+  }
+};
+
+// Escritor Columnar - Acumula filas hasta completar un grupo y entonces
+// codifica sus columnas en paralelo y lo escribe, así la memoria usada queda
+// acotada por el tamaño del grupo y no por el de la tabla.
+class EscritorColumnar {
+private:
+  // Posición y tamaño de una porción ya escrita, para los metadatos
+  struct PorcionEscrita {
+    std::uint64_t inicio;      // Primera página (diccionario o datos)
+    std::uint64_t inicioDatos; // Página de datos
+    std::uint64_t bytesComprimidos;
+    std::uint64_t bytesSinComprimir;
+    bool conDiccionario;
+  };
+  struct GrupoEscrito {
+    std::uint64_t filas;
+    std::vector<PorcionEscrita> porciones;
+  };
+
+  std::ostream &salida;
+  std::vector<FormatoColumnar::Columna> esquema;
+  std::vector<FormatoColumnar::ValoresColumna> valores;
+  std::vector<FormatoColumnar::PorcionColumna> porciones;
+  std::size_t filasPorGrupo;
+  std::size_t filasEnGrupo = 0;
+  std::uint64_t bytesEscritos = 0;
+  std::vector<GrupoEscrito> grupos;
+  bool valido = true;
+
+  void escribir(std::string_view datos) {
+    salida.write(datos.data(), static_cast<std::streamsize>(datos.size()));
+    bytesEscritos += datos.size();
+  }
+
+  // Codifica y escribe el grupo en curso
+  bool vaciarGrupo() {
+    if (filasEnGrupo == 0) {
+      return valido;
+    }
+    PoolHilos::global().paraCadaBloque(
+        esquema.size(), 1,
+        [this](std::size_t columna, std::size_t, std::size_t) {
+          FormatoColumnar::codificarColumna(esquema[columna].tipo,
+                                            valores[columna],
+                                            porciones[columna]);
+        });
+
+    GrupoEscrito grupo{filasEnGrupo, {}};
+    for (std::size_t columna = 0; columna < esquema.size(); ++columna) {
+      const auto &porcion = porciones[columna];
+      grupo.porciones.push_back(
+          {bytesEscritos, bytesEscritos + porcion.inicioDatos,
+           porcion.bytes.size(), porcion.bytesSinComprimir,
+           porcion.conDiccionario});
+      escribir(porcion.bytes);
+      valores[columna].limpiar();
+    }
+    grupos.push_back(std::move(grupo));
+    filasEnGrupo = 0;
+    valido = valido && static_cast<bool>(salida);
+    return valido;
+  }
+
+public:
+  // Constructor - La salida debe estar abierta en modo binario
+  EscritorColumnar(std::ostream &salida,
+                   std::vector<FormatoColumnar::Columna> esquema,
+                   std::size_t filasPorGrupo = 65536)
+      : salida(salida), esquema(std::move(esquema)),
+        valores(this->esquema.size()), porciones(this->esquema.size()),
+        filasPorGrupo(std::max<std::size_t>(filasPorGrupo, 1)) {
+    escribir(FormatoColumnar::MAGIA);
+  }
+
+  // Métodos para agregar el valor de una columna en la fila en curso
+  void agregarEntero(std::size_t columna, std::int64_t valor) {
+    valores[columna].enteros.push_back(valor);
+  }
+  void agregarReal(std::size_t columna, double valor) {
+    valores[columna].reales.push_back(valor);
+  }
+  void agregarTexto(std::size_t columna, std::string valor) {
+    valores[columna].textos.push_back(std::move(valor));
+  }
+
+  // Método para cerrar la fila en curso. Devuelve false si a alguna columna
+  // le falta o le sobra un valor, o si falló la escritura
+  bool terminarFila() {
+    for (std::size_t columna = 0; columna < esquema.size(); ++columna) {
+      if (valores[columna].cantidad(esquema[columna].tipo) !=
+          filasEnGrupo + 1) {
+        valido = false;
+      }
+    }
+    if (!valido) {
+      return false;
+    }
+    if (++filasEnGrupo == filasPorGrupo) {
+      return vaciarGrupo();
+    }
+    return true;
+  }
+
+  // Método para escribir el último grupo y los metadatos del archivo
+  bool cerrar() {
+    using Thrift = FormatoColumnar::EscritorThrift;
+    if (!vaciarGrupo()) {
+      return false;
+    }
+    std::uint64_t filas = 0;
+    for (const auto &grupo : grupos) {
+      filas += grupo.filas;
+    }
+
+    std::string pie;
+    Thrift thrift(pie);
+    thrift.i32(1, 1); // Versión del formato
+    thrift.iniciarLista(2, Thrift::T_ESTRUCTURA, esquema.size() + 1);
+    thrift.iniciarElemento(); // Raíz del esquema
+    thrift.binario(4, "schema");
+    thrift.i32(5, static_cast<std::int32_t>(esquema.size()));
+    thrift.terminarEstructura();
+    for (const auto &columna : esquema) {
+      thrift.iniciarElemento();
+      thrift.i32(1, FormatoColumnar::tipoFisico(columna.tipo));
+      thrift.i32(3, FormatoColumnar::REQUIRED);
+      thrift.binario(4, columna.nombre);
+      if (columna.tipo == FormatoColumnar::COL_TEXTO) {
+        thrift.i32(6, FormatoColumnar::UTF8);
+      }
+      thrift.terminarEstructura();
+    }
+    thrift.i64(3, static_cast<std::int64_t>(filas));
+
+    thrift.iniciarLista(4, Thrift::T_ESTRUCTURA, grupos.size());
+    for (const auto &grupo : grupos) {
+      std::uint64_t bytesGrupo = 0;
+      thrift.iniciarElemento();
+      thrift.iniciarLista(1, Thrift::T_ESTRUCTURA, esquema.size());
+      for (std::size_t c = 0; c < esquema.size(); ++c) {
+        const PorcionEscrita &porcion = grupo.porciones[c];
+        bytesGrupo += porcion.bytesSinComprimir;
+        thrift.iniciarElemento();
+        thrift.i64(2, static_cast<std::int64_t>(porcion.inicio));
+        thrift.iniciarEstructura(3);
+        thrift.i32(1, FormatoColumnar::tipoFisico(esquema[c].tipo));
+        thrift.iniciarLista(2, Thrift::T_I32, porcion.conDiccionario ? 3 : 2);
+        thrift.elementoI32(FormatoColumnar::PLAIN);
+        thrift.elementoI32(FormatoColumnar::RLE);
+        if (porcion.conDiccionario) {
+          thrift.elementoI32(FormatoColumnar::RLE_DICTIONARY);
+        }
+        thrift.iniciarLista(3, Thrift::T_BINARIO, 1);
+        thrift.elementoBinario(esquema[c].nombre);
+        thrift.i32(4, FormatoColumnar::SNAPPY);
+        thrift.i64(5, static_cast<std::int64_t>(grupo.filas));
+        thrift.i64(6, static_cast<std::int64_t>(porcion.bytesSinComprimir));
+        thrift.i64(7, static_cast<std::int64_t>(porcion.bytesComprimidos));
+        thrift.i64(9, static_cast<std::int64_t>(porcion.inicioDatos));
+        if (porcion.conDiccionario) {
+          thrift.i64(11, static_cast<std::int64_t>(porcion.inicio));
+        }
+        thrift.terminarEstructura(); // Metadatos de la porción
+        thrift.terminarEstructura(); // Porción
+      }
+      thrift.i64(2, static_cast<std::int64_t>(bytesGrupo));
+      thrift.i64(3, static_cast<std::int64_t>(grupo.filas));
+      thrift.terminarEstructura();
+    }
+    thrift.binario(6, "banco-preguntas");
+    thrift.terminarEstructura();
+
+    // Largo de los metadatos en 4 bytes (little-endian) y la marca final
+    FormatoColumnar::escribirLE(pie, pie.size(), 4);
+    pie += FormatoColumnar::MAGIA;
+    escribir(pie);
+    salida.flush();
+    return static_cast<bool>(salida);
+  }
+};
+
+// Lector Columnar - Lee los metadatos de un archivo Parquet con columnas
+// REQUIRED de tipo INT64, DOUBLE o BYTE_ARRAY y decodifica un grupo por vez
+class LectorColumnar {
+private:
+  // Ubicación de una porción de columna dentro del archivo
+  struct Porcion {
+    std::uint64_t inicio = 0;
+    std::uint64_t bytes = 0;
+    int compresion = FormatoColumnar::SIN_COMPRESION;
+  };
+  struct Grupo {
+    std::uint64_t filas = 0;
+    std::vector<Porcion> porciones;
+  };
+
+  std::istream &entrada;
+  std::vector<FormatoColumnar::Columna> esquema;
+  std::vector<Grupo> grupos;
+
+  using Thrift = FormatoColumnar::EscritorThrift;
+
+  // Lee el esquema: una raíz con una hoja por columna
+  bool leerEsquema(FormatoColumnar::LectorThrift &thrift) {
+    int tipoElemento;
+    std::size_t elementos = thrift.lista(tipoElemento);
+    if (elementos == 0 || tipoElemento != Thrift::T_ESTRUCTURA) {
+      return false;
+    }
+    esquema.clear();
+    for (std::size_t e = 0; e < elementos; ++e) {
+      std::int64_t tipo = -1, repeticion = -1, hijos = 0;
+      std::string nombre;
+      int campo, tipoCampo;
+      thrift.entrarEstructura();
+      while (thrift.siguienteCampo(campo, tipoCampo)) {
+        if (campo == 1 && tipoCampo == Thrift::T_I32) {
+          tipo = thrift.entero();
+        } else if (campo == 3 && tipoCampo == Thrift::T_I32) {
+          repeticion = thrift.entero();
+        } else if (campo == 4 && tipoCampo == Thrift::T_BINARIO) {
+          nombre = thrift.binario();
+        } else if (campo == 5 && tipoCampo == Thrift::T_I32) {
+          hijos = thrift.entero();
+        } else {
+          thrift.saltar(tipoCampo);
+        }
+      }
+      thrift.salirEstructura();
+      if (e == 0) {
+        if (hijos != static_cast<std::int64_t>(elementos) - 1) {
+          return false; // Solo se admiten columnas planas
+        }
+        continue;
+      }
+      if (hijos != 0 || repeticion != FormatoColumnar::REQUIRED) {
+        return false;
+      }
+      if (tipo == FormatoColumnar::INT64) {
+        esquema.push_back({nombre, FormatoColumnar::COL_ENTERO});
+      } else if (tipo == FormatoColumnar::DOUBLE) {
+        esquema.push_back({nombre, FormatoColumnar::COL_REAL});
+      } else if (tipo == FormatoColumnar::BYTE_ARRAY) {
+        esquema.push_back({nombre, FormatoColumnar::COL_TEXTO});
+      } else {
+        return false;
+      }
+    }
+    return thrift.esValido();
+  }
+
+  // Lee los metadatos de una porción de columna
+  bool leerPorcion(FormatoColumnar::LectorThrift &thrift, Porcion &porcion) {
+    std::int64_t datos = -1, diccionario = -1, comprimidos = -1;
+    int campo, tipoCampo;
+    thrift.entrarEstructura();
+    while (thrift.siguienteCampo(campo, tipoCampo)) {
+      if (campo != 3 || tipoCampo != Thrift::T_ESTRUCTURA) {
+        thrift.saltar(tipoCampo);
+        continue;
+      }
+      thrift.entrarEstructura();
+      while (thrift.siguienteCampo(campo, tipoCampo)) {
+        if (campo == 4 && tipoCampo == Thrift::T_I32) {
+          porcion.compresion = static_cast<int>(thrift.entero());
+        } else if (campo == 7 && tipoCampo == Thrift::T_I64) {
+          comprimidos = thrift.entero();
+        } else if (campo == 9 && tipoCampo == Thrift::T_I64) {
+          datos = thrift.entero();
+        } else if (campo == 11 && tipoCampo == Thrift::T_I64) {
+          diccionario = thrift.entero();
+        } else {
+          thrift.saltar(tipoCampo);
+        }
+      }
+      thrift.salirEstructura();
+    }
+    thrift.salirEstructura();
+    std::int64_t inicio = diccionario >= 0 ? diccionario : datos;
+    if (inicio < 0 || comprimidos < 0) {
+      return false;
+    }
+    porcion.inicio = static_cast<std::uint64_t>(inicio);
+    porcion.bytes = static_cast<std::uint64_t>(comprimidos);
+    return thrift.esValido();
+  }
+
+  // Lee la lista de grupos de filas
+  bool leerGrupos(FormatoColumnar::LectorThrift &thrift) {
+    int tipoElemento;
+    std::size_t cantidad = thrift.lista(tipoElemento);
+    if (cantidad > 0 && tipoElemento != Thrift::T_ESTRUCTURA) {
+      return false;
+    }
+    grupos.assign(cantidad, {});
+    for (Grupo &grupo : grupos) {
+      int campo, tipoCampo;
+      thrift.entrarEstructura();
+      while (thrift.siguienteCampo(campo, tipoCampo)) {
+        if (campo == 1 && tipoCampo == Thrift::T_LISTA) {
+          std::size_t porciones = thrift.lista(tipoElemento);
+          if (porciones != esquema.size() ||
+              tipoElemento != Thrift::T_ESTRUCTURA) {
+            return false;
+          }
+          grupo.porciones.resize(porciones);
+          for (Porcion &porcion : grupo.porciones) {
+            if (!leerPorcion(thrift, porcion)) {
+              return false;
+            }
+          }
+        } else if (campo == 3 && tipoCampo == Thrift::T_I64) {
+          std::int64_t filas = thrift.entero();
+          grupo.filas = filas > 0 ? static_cast<std::uint64_t>(filas) : 0;
+        } else {
+          thrift.saltar(tipoCampo);
+        }
+      }
+      thrift.salirEstructura();
+      if (grupo.porciones.size() != esquema.size()) {
+        return false;
+      }
+    }
+    return thrift.esValido();
+  }
+
+public:
+  explicit LectorColumnar(std::istream &entrada) : entrada(entrada) {}
+
+  // Método para leer el esquema y el índice de grupos
+  bool abrir() {
+    char marca[8];
+    entrada.seekg(0, std::ios::end);
+    std::streamoff total = entrada.tellg();
+    entrada.seekg(0);
+    if (total < 12 || !entrada.read(marca, 4) ||
+        std::string_view(marca, 4) != FormatoColumnar::MAGIA) {
+      return false;
+    }
+    entrada.seekg(total - 8);
+    if (!entrada.read(marca, 8) ||
+        std::string_view(marca + 4, 4) != FormatoColumnar::MAGIA) {
+      return false;
+    }
+    std::size_t posLargo = 0;
+    std::uint64_t largo;
+    FormatoColumnar::leerLE(std::string_view(marca, 4), posLargo, 4, largo);
+    if (largo > static_cast<std::uint64_t>(total - 12)) {
+      return false;
+    }
+    std::string pie(largo, '\0');
+    std::uint64_t finDatos = total - 8 - largo;
+    entrada.seekg(static_cast<std::streamoff>(finDatos));
+    if (!entrada.read(pie.data(), static_cast<std::streamsize>(largo))) {
+      return false;
+    }
+
+    FormatoColumnar::LectorThrift thrift(pie);
+    bool hayEsquema = false;
+    int campo, tipoCampo;
+    grupos.clear();
+    while (thrift.siguienteCampo(campo, tipoCampo)) {
+      if (campo == 2 && tipoCampo == Thrift::T_LISTA) {
+        if (!leerEsquema(thrift)) {
+          return false;
+        }
+        hayEsquema = true;
+      } else if (campo == 4 && tipoCampo == Thrift::T_LISTA) {
+        // El esquema va antes que los grupos (campo 2 < campo 4)
+        if (!hayEsquema || !leerGrupos(thrift)) {
+          return false;
+        }
+      } else {
+        thrift.saltar(tipoCampo);
+      }
+    }
+    if (!thrift.esValido() || !hayEsquema) {
+      return false;
+    }
+    for (const Grupo &grupo : grupos) {
+      for (const Porcion &porcion : grupo.porciones) {
+        if (porcion.inicio < 4 || porcion.inicio > finDatos ||
+            porcion.bytes > finDatos - porcion.inicio) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  // Método para decodificar un grupo de filas (una entrada por columna).
+  // Las porciones se leen en orden y se decodifican en paralelo
+  bool leerGrupo(std::size_t grupo,
+                 std::vector<FormatoColumnar::ValoresColumna> &columnas) {
+    if (grupo >= grupos.size()) {
+      return false;
+    }
+    const Grupo &actual = grupos[grupo];
+    std::vector<std::string> bloques(esquema.size());
+    for (std::size_t c = 0; c < esquema.size(); ++c) {
+      const Porcion &porcion = actual.porciones[c];
+      bloques[c].resize(porcion.bytes);
+      entrada.clear();
+      entrada.seekg(static_cast<std::streamoff>(porcion.inicio));
+      if (!entrada.read(bloques[c].data(),
+                        static_cast<std::streamsize>(porcion.bytes))) {
+        return false;
+      }
+    }
+
+    columnas.assign(esquema.size(), {});
+    std::atomic<bool> correcto{true};
+    PoolHilos::global().paraCadaBloque(
+        esquema.size(), 1, [&](std::size_t c, std::size_t, std::size_t) {
+          if (!FormatoColumnar::decodificarColumna(
+                  esquema[c].tipo, bloques[c], actual.filas,
+                  actual.porciones[c].compresion, columnas[c])) {
+            correcto = false;
+          }
+        });
+    return correcto;
+  }
+
+  // Getters
+  const std::vector<FormatoColumnar::Columna> &getEsquema() const {
+    return esquema;
+  }
+  std::size_t getCantidadGrupos() const { return grupos.size(); }
+  std::uint64_t getCantidadFilas() const {
+    std::uint64_t total = 0;
+    for (const auto &grupo : grupos) {
+      total += grupo.filas;
+    }
+    return total;
+  }
+};
+
+// Respuesta de un estudiante a una pregunta, para el análisis de resultados
+struct RespuestaEstudiante {
+  std::string estudiante;
+  int preguntaId = 0;
+  bool correcta = false;
+  double puntaje = 0.0;
+  double segundos = 0.0; // Tiempo empleado en responder
+};
+
+// Archivo de Respuestas - Respuestas de estudiantes en texto, una por línea
+// con campos separados por tabuladores (con el mismo escape que
+// ArchivoBanco): estudiante, ID de la pregunta, correcta (1/0), puntaje y
+// segundos. Las líneas que empiezan con '#' son comentarios. Se lee como
+// flujo, así un archivo con millones de respuestas no se carga completo.
+class ArchivoRespuestas {
+private:
+  std::ifstream entrada;
+  std::size_t invalidas = 0; // Líneas descartadas por no ser válidas
+
+public:
+  static constexpr const char *ENCABEZADO = "#RESPUESTAS 1";
+
+  // Método para convertir una respuesta en una línea del archivo
+  static std::string serializar(const RespuestaEstudiante &r) {
+    std::ostringstream salida;
+    salida.precision(17);
+    salida << ArchivoBanco::escapar(r.estudiante) << '\t' << r.preguntaId
+           << '\t' << (r.correcta ? 1 : 0) << '\t' << r.puntaje << '\t'
+           << r.segundos;
+    return salida.str();
+  }
+
+  // Método para leer una respuesta desde una línea. Devuelve false si falta
+  // un campo o algún valor está fuera de rango
+  static bool deserializar(const std::string &linea, RespuestaEstudiante &r) {
+    std::vector<std::string> c = ArchivoBanco::separarCampos(linea);
+    int correcta;
+    if (c.size() != 5 || c[0].empty() ||
+        !ArchivoBanco::leerNumero(c[1], r.preguntaId) ||
+        !ArchivoBanco::leerNumero(c[2], correcta) ||
+        !ArchivoBanco::leerNumero(c[3], r.puntaje) ||
+        !ArchivoBanco::leerNumero(c[4], r.segundos) || r.preguntaId <= 0 ||
+        (correcta != 0 && correcta != 1) || !std::isfinite(r.puntaje) ||
+        !std::isfinite(r.segundos) || r.segundos < 0.0) {
+      return false;
+    }
+    r.estudiante = std::move(c[0]);
+    r.correcta = correcta == 1;
+    return true;
+  }
+
+  // Método para guardar respuestas en un archivo
+  static bool guardar(const std::string &ruta,
+                      const std::vector<RespuestaEstudiante> &respuestas) {
+    std::ofstream salida(ruta);
+    if (!salida) {
+      return false;
+    }
+    salida << ENCABEZADO << "\n";
+    for (const RespuestaEstudiante &r : respuestas) {
+      salida << serializar(r) << "\n";
+    }
+    return static_cast<bool>(salida);
+  }
+
+  // Constructor - Abre el archivo para leerlo como flujo
+  explicit ArchivoRespuestas(const std::string &ruta) : entrada(ruta) {}
+
+  bool estaAbierto() const { return entrada.is_open(); }
+
+  // Método para leer la siguiente respuesta válida; false al terminar
+  bool siguiente(RespuestaEstudiante &respuesta) {
+    std::string linea;
+    while (std::getline(entrada, linea)) {
+      if (!linea.empty() && linea.back() == '\r') {
+        linea.pop_back();
+      }
+      if (linea.empty() || linea[0] == '#') {
+        continue;
+      }
+      if (deserializar(linea, respuesta)) {
+        return true;
+      }
+      invalidas++;
+    }
+    return false;
+  }
+
+  std::size_t getInvalidas() const { return invalidas; }
+};
+
+// Exportador Analítico - Escribe el banco y los resultados en Parquet: una
+// tabla de preguntas, una de opciones (listas de opción múltiple y de
+// emparejamiento) y una de respuestas de estudiantes.
+class ExportadorAnalitico {
+public:
+  // Método para exportar los metadatos de las preguntas
+  static bool exportarPreguntas(const GestorPreguntas &gestor,
+                                std::ostream &salida,
+                                std::size_t filasPorGrupo = 65536) {
+    EscritorColumnar escritor(salida,
+                              {{"id", FormatoColumnar::COL_ENTERO},
+                               {"tipo", FormatoColumnar::COL_TEXTO},
+                               {"nivel_bloom", FormatoColumnar::COL_ENTERO},
+                               {"tiempo_estimado", FormatoColumnar::COL_ENTERO},
+                               {"anio", FormatoColumnar::COL_ENTERO},
+                               {"discriminacion", FormatoColumnar::COL_REAL},
+                               {"dificultad", FormatoColumnar::COL_REAL},
+                               {"grupo_tematico", FormatoColumnar::COL_ENTERO},
+                               {"respuesta", FormatoColumnar::COL_ENTERO},
+                               {"texto", FormatoColumnar::COL_TEXTO}},
+                              filasPorGrupo);
+    for (const Pregunta &p : gestor.vistaPreguntas()) {
+      // Opción correcta, 1/0 en verdadero/falso y -1 en emparejamiento
+      int respuesta = -1;
+      if (auto *pom = dynamic_cast<const PreguntaOpcionMultiple *>(&p)) {
+        respuesta = pom->getOpcionCorrecta();
+      } else if (auto *pvf = dynamic_cast<const PreguntaVerdaderoFalso *>(&p)) {
+        respuesta = pvf->getRespuestaCorrecta() ? 1 : 0;
+      }
+      escritor.agregarEntero(0, p.getId());
+      escritor.agregarTexto(1, p.getTipo());
+      escritor.agregarEntero(2, p.getNivelBloom());
+      escritor.agregarEntero(3, p.getTiempoEstimado());
+      escritor.agregarEntero(4, p.getAnio());
+      escritor.agregarReal(5, p.getDiscriminacion());
+      escritor.agregarReal(6, p.getDificultad());
+      escritor.agregarEntero(7, p.getGrupoTematico());
+      escritor.agregarEntero(8, respuesta);
+      escritor.agregarTexto(9, p.getTexto());
+      if (!escritor.terminarFila()) {
+        return false;
+      }
+    }
+    return escritor.cerrar();
+  }
+
+  // Método para exportar las listas de las preguntas. La columna "clave" es
+  // 1/0 en opción múltiple, la posición emparejada en la lista izquierda y
+  // -1 en la derecha
+  static bool exportarOpciones(const GestorPreguntas &gestor,
+                               std::ostream &salida,
+                               std::size_t filasPorGrupo = 65536) {
+    EscritorColumnar escritor(salida,
+                              {{"pregunta_id", FormatoColumnar::COL_ENTERO},
+                               {"lista", FormatoColumnar::COL_TEXTO},
+                               {"posicion", FormatoColumnar::COL_ENTERO},
+                               {"clave", FormatoColumnar::COL_ENTERO},
+                               {"texto", FormatoColumnar::COL_TEXTO}},
+                              filasPorGrupo);
+    auto agregarFila = [&](int id, const char *lista, int posicion, int clave,
+                           const std::string &texto) {
+      escritor.agregarEntero(0, id);
+      escritor.agregarTexto(1, lista);
+      escritor.agregarEntero(2, posicion);
+      escritor.agregarEntero(3, clave);
+      escritor.agregarTexto(4, texto);
+      return escritor.terminarFila();
+    };
+
+    for (const Pregunta &p : gestor.vistaPreguntas()) {
+      bool correcto = true;
+      if (auto *pom = dynamic_cast<const PreguntaOpcionMultiple *>(&p)) {
+        const auto &opciones = pom->getOpciones();
+        for (int i = 0; correcto && i < static_cast<int>(opciones.size());
+             ++i) {
+          correcto = agregarFila(p.getId(), "opcion", i,
+                                 i == pom->getOpcionCorrecta() ? 1 : 0,
+                                 opciones[i]);
+        }
+      } else if (auto *pe = dynamic_cast<const PreguntaEmparejamiento *>(&p)) {
+        const auto &izquierda = pe->getElementosIzquierda();
+        const auto &derecha = pe->getElementosDerecha();
+        const auto &pares = pe->getEmparejamientosCorrectos();
+        for (int i = 0; correcto && i < static_cast<int>(izquierda.size());
+             ++i) {
+          int clave = i < static_cast<int>(pares.size()) ? pares[i] : -1;
+          correcto =
+              agregarFila(p.getId(), "izquierda", i, clave, izquierda[i]);
+        }
+        for (int i = 0; correcto && i < static_cast<int>(derecha.size()); ++i) {
+          correcto = agregarFila(p.getId(), "derecha", i, -1, derecha[i]);
+        }
+      }
+      if (!correcto) {
+        return false;
+      }
+    }
+    return escritor.cerrar();
+  }
+
+  // Método para exportar respuestas de estudiantes. 'siguiente' entrega una
+  // respuesta por llamada y devuelve false al terminar, así la tabla no
+  // necesita estar completa en memoria
+  static bool exportarRespuestas(
+      std::ostream &salida,
+      const std::function<bool(RespuestaEstudiante &)> &siguiente,
+      std::size_t filasPorGrupo = 65536) {
+    EscritorColumnar escritor(salida,
+                              {{"estudiante", FormatoColumnar::COL_TEXTO},
+                               {"pregunta_id", FormatoColumnar::COL_ENTERO},
+                               {"correcta", FormatoColumnar::COL_ENTERO},
+                               {"puntaje", FormatoColumnar::COL_REAL},
+                               {"segundos", FormatoColumnar::COL_REAL}},
+                              filasPorGrupo);
+    RespuestaEstudiante respuesta;
+    while (siguiente(respuesta)) {
+      escritor.agregarTexto(0, respuesta.estudiante);
+      escritor.agregarEntero(1, respuesta.preguntaId);
+      escritor.agregarEntero(2, respuesta.correcta ? 1 : 0);
+      escritor.agregarReal(3, respuesta.puntaje);
+      escritor.agregarReal(4, respuesta.segundos);
+      if (!escritor.terminarFila()) {
+        return false;
+      }
+    }
+    return escritor.cerrar();
+  }
+
+  // Método para ejecutar la exportación desde la línea de comandos:
+  //   --exportar-columnar <banco> <prefijo> [respuestas]
+  // Genera <prefijo>_preguntas.parquet, <prefijo>_opciones.parquet y, si se
+  // indica un archivo de respuestas, <prefijo>_respuestas.parquet
+  static int ejecutar(const std::vector<std::string> &args) {
+    if (args.size() < 3 || args.size() > 4 ||
+        args[0] != "--exportar-columnar") {
+      std::cout << "Uso:\n  --exportar-columnar <banco> <prefijo> "
+                   "[respuestas]\n";
+      return 1;
+    }
+    GestorPreguntas gestor;
+    if (ArchivoBanco::cargar(args[1], gestor) < 0) {
+      std::cout << "Error: No se pudo leer el archivo de banco.\n";
+      return 1;
+    }
+    std::ofstream preguntas(args[2] + "_preguntas.parquet", std::ios::binary);
+    std::ofstream opciones(args[2] + "_opciones.parquet", std::ios::binary);
+    if (!preguntas || !opciones || !exportarPreguntas(gestor, preguntas) ||
+        !exportarOpciones(gestor, opciones)) {
+      std::cout << "Error: No se pudieron escribir los archivos.\n";
+      return 1;
+    }
+    std::cout << "Exportadas " << gestor.getCantidadPreguntas()
+              << " preguntas.\n";
+
+    if (args.size() == 4) {
+      ArchivoRespuestas entrada(args[3]);
+      if (!entrada.estaAbierto()) {
+        std::cout << "Error: No se pudo leer el archivo de respuestas.\n";
+        return 1;
+      }
+      std::ofstream respuestas(args[2] + "_respuestas.parquet",
+                               std::ios::binary);
+      std::size_t exportadas = 0;
+      bool correcto =
+          respuestas && exportarRespuestas(respuestas,
+                                           [&](RespuestaEstudiante &r) {
+                                             bool hay = entrada.siguiente(r);
+                                             exportadas += hay ? 1 : 0;
+                                             return hay;
+                                           });
+      if (!correcto) {
+        std::cout << "Error: No se pudieron escribir las respuestas.\n";
+        return 1;
+      }
+      std::cout << "Exportadas " << exportadas << " respuestas";
+      if (entrada.getInvalidas() > 0) {
+        std::cout << " (" << entrada.getInvalidas()
+                  << " líneas inválidas omitidas)";
+      }
+      std::cout << ".\n";
+    }
+    return 0;
+  }
+};
+
+// Reporte de Compresión - Entrena un almacén con los textos de un banco, lo
+// carga en modo comprimido y lo compara con la versión sin comprimir: bytes
+// de texto guardados y tiempo medio de acceso a los textos de una pregunta.
+class ReporteCompresion {
+public:
+  struct Resultado {
+    std::size_t bytesOriginales = 0;  // Enunciados y listas tal cual
+    std::size_t bytesComprimidos = 0; // Enunciados comprimidos + internados
+    double nsAccesoPlano = 0.0;       // Por pregunta, sin comprimir
+    double nsAccesoComprimido = 0.0;  // Por pregunta, comprimido
+
+    double getRazon() const {
+      return bytesComprimidos > 0
+                 ? static_cast<double>(bytesOriginales) / bytesComprimidos
+                 : 0.0;
+    }
+  };
+
+  // Método para leer la memoria residente del proceso (VmRSS de
+  // /proc/self/status) en bytes. Incluye todo lo que ocupa el banco: textos,
+  // índices, historial y caché. Devuelve 0 si no está disponible
+  static std::size_t memoriaProceso() {
+    std::ifstream estado("/proc/self/status");
+    std::string linea;
+    while (std::getline(estado, linea)) {
+      if (linea.starts_with("VmRSS:")) {
+        std::size_t kib = 0;
+        std::istringstream(linea.substr(6)) >> kib;
+        return kib * 1024;
+      }
+    }
+    return 0;
+  }
+
+  // Método para obtener todos los textos de una pregunta (enunciado y listas)
+  static std::vector<std::string> textosDe(const Pregunta &p) {
+    std::vector<std::string> textos{p.getTexto()};
+    auto agregar = [&textos](const ListaTextos &lista) {
+      for (std::string_view texto : lista) {
+        textos.emplace_back(texto);
+      }
+    };
+    if (auto *pom = dynamic_cast<const PreguntaOpcionMultiple *>(&p)) {
+      agregar(pom->getOpciones());
+    } else if (auto *pe = dynamic_cast<const PreguntaEmparejamiento *>(&p)) {
+      agregar(pe->getElementosIzquierda());
+      agregar(pe->getElementosDerecha());
+    }
+    return textos;
+  }
+
+  // Método para entrenar un almacén con los textos de un banco
+  static std::shared_ptr<AlmacenTextos>
+  entrenar(const GestorPreguntas &gestor) {
+    std::vector<std::string> muestras;
+    for (const Pregunta &p : gestor.vistaPreguntas()) {
+      std::ranges::move(textosDe(p), std::back_inserter(muestras));
+    }
+    return AlmacenTextos::entrenar(muestras);
+  }
+
+  // Método para medir el tiempo medio de leer todos los textos de una
+  // pregunta del banco
+  static double medirAcceso(const GestorPreguntas &gestor, int repeticiones) {
+    std::size_t total = 0;
+    auto inicio = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeticiones; ++r) {
+      for (const Pregunta &p : gestor.vistaPreguntas()) {
+        for (const std::string &texto : textosDe(p)) {
+          total += texto.size();
+        }
+      }
+    }
+    auto fin = std::chrono::steady_clock::now();
+    std::size_t accesos =
+        static_cast<std::size_t>(repeticiones) * gestor.getCantidadPreguntas();
+    if (accesos == 0 || total == 0) {
+      return 0.0;
+    }
+    return std::chrono::duration<double, std::nano>(fin - inicio).count() /
+           accesos;
+  }
+
+  // Método para comparar un banco sin comprimir con su copia comprimida
+  static Resultado comparar(const GestorPreguntas &plano,
+                            const GestorPreguntas &comprimido) {
+    Resultado resultado;
+    const auto &almacen = comprimido.getAlmacenTextos();
+    for (const Pregunta &p : plano.vistaPreguntas()) {
+      for (const std::string &texto : textosDe(p)) {
+        resultado.bytesOriginales += texto.size();
+      }
+    }
+    if (almacen) {
+      for (const Pregunta &p : comprimido.vistaPreguntas()) {
+        resultado.bytesComprimidos += almacen->comprimir(p.getTexto()).size();
+      }
+      resultado.bytesComprimidos += almacen->getEstadisticas().bytesInternados;
+    }
+    int repeticiones = std::max<std::size_t>(
+        1, 1000000 / std::max<std::size_t>(1, plano.getCantidadPreguntas()));
+    resultado.nsAccesoPlano = medirAcceso(plano, repeticiones);
+    resultado.nsAccesoComprimido = medirAcceso(comprimido, repeticiones);
+    return resultado;
+  }
+
+  // Método para ejecutar el reporte desde la línea de comandos:
+  //   --reporte-compresion <banco>
+  static int ejecutar(const std::vector<std::string> &args) {
+    if (args.size() != 2 || args[0] != "--reporte-compresion") {
+      std::cout << "Uso:\n  --reporte-compresion <banco>\n";
+      return 1;
+    }
+    // La memoria de cada banco es lo que crece el proceso al cargarlo (el
+    // comprimido incluye su almacén). Es aproximada: el asignador puede
+    // reutilizar memoria liberada o no devolverla al sistema
+    std::size_t memoriaInicial = memoriaProceso();
+    GestorPreguntas plano, comprimido;
+    if (ArchivoBanco::cargar(args[1], plano) < 0) {
+      std::cout << "Error: No se pudo leer el archivo de banco.\n";
+      return 1;
+    }
+    std::size_t memoriaPlano = memoriaProceso();
+    auto almacen = entrenar(plano);
+    comprimido.setAlmacenTextos(almacen);
+    ArchivoBanco::cargar(args[1], comprimido);
+    std::size_t memoriaFinal = memoriaProceso();
+
+    Resultado resultado = comparar(plano, comprimido);
+    auto estadisticas = almacen->getEstadisticas();
+    std::cout << "Preguntas: " << comprimido.getCantidadPreguntas()
+              << ", símbolos: " << almacen->getCantidadSimbolos() << "\n"
+              << "Bytes de texto: " << resultado.bytesOriginales << " -> "
+              << resultado.bytesComprimidos << " (razón "
+              << resultado.getRazon() << ")\n"
+              << "Textos de listas internados: " << estadisticas.internados
+              << " distintos de " << estadisticas.referencias << "\n"
+              << "Acceso por pregunta: " << resultado.nsAccesoPlano
+              << " ns sin comprimir, " << resultado.nsAccesoComprimido
+              << " ns comprimido\n";
+    if (memoriaFinal == 0) {
+      std::cout << "Memoria del proceso: no disponible\n";
+    } else {
+      auto kib = [](std::size_t desde, std::size_t hasta) {
+        return hasta > desde ? (hasta - desde) / 1024 : 0;
+      };
+      std::cout << "Memoria del proceso: " << memoriaFinal / 1024
+                << " KiB (banco sin comprimir +"
+                << kib(memoriaInicial, memoriaPlano)
+                << " KiB, comprimido +" << kib(memoriaPlano, memoriaFinal)
+                << " KiB)\n";
+    }
+    return 0;
+  }
+};
+
+// Renderizador de Exámenes - Genera el examen y la pauta de cada estudiante.
+// Cada variante reordena las preguntas y sus alternativas con su propia
+// semilla, así una misma semilla reproduce siempre los mismos documentos. Las
+// variantes se renderizan en paralelo en el pool y cada bloque reutiliza sus
+// buffers de salida.
+class RenderizadorExamenes {
+public:
+  // Orden de una variante
+  struct OrdenVariante {
+    std::vector<std::size_t> preguntas;         // Índices en el orden mostrado
+    std::vector<std::vector<int>> alternativas; // Por índice de pregunta
+  };
+
+  // Recibe (índice de la variante, examen, pauta). Se llama desde varios
+  // hilos a la vez; los textos solo son válidos durante la llamada
+  using Destino = std::function<void(std::size_t, const std::string &,
+                                     const std::string &)>;
+
+  // Semilla de la variante 'indice' (mezcla splitmix64)
+  static std::uint64_t semillaVariante(std::uint64_t semilla,
+                                       std::size_t indice) {
+    std::uint64_t z = semilla + 0x9E3779B97F4A7C15ull * (indice + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+  // Método para sortear el orden de una variante
+  static void generarOrden(const std::vector<const Pregunta *> &preguntas,
+                           std::uint64_t semilla, OrdenVariante &orden) {
+    std::mt19937_64 generador(semilla);
+    orden.preguntas.resize(preguntas.size());
+    std::iota(orden.preguntas.begin(), orden.preguntas.end(), 0);
+    std::ranges::shuffle(orden.preguntas, generador);
+    orden.alternativas.resize(preguntas.size());
+    for (std::size_t i = 0; i < preguntas.size(); ++i) {
+      auto &alternativas = orden.alternativas[i];
+      alternativas.resize(preguntas[i]->getCantidadAlternativas());
+      std::iota(alternativas.begin(), alternativas.end(), 0);
+      std::ranges::shuffle(alternativas, generador);
+    }
+  }
+
+  // Método para renderizar una variante en 'examen' y 'clave' (se vacían
+  // antes, conservando su capacidad)
+  static void renderizarVariante(const std::vector<const Pregunta *> &preguntas,
+                                 const OrdenVariante &orden,
+                                 const PlantillaExamen &plantilla,
+                                 const std::string &titulo,
+                                 const std::string &estudiante, int variante,
+                                 std::string &examen, std::string &clave) {
+    examen.clear();
+    clave.clear();
+    std::array<char, 12> bufVariante, bufNumero;
+    PlantillaTexto::Valores valores{};
+    valores[PlantillaTexto::VAR_TITULO] = titulo;
+    valores[PlantillaTexto::VAR_ESTUDIANTE] = estudiante;
+    valores[PlantillaTexto::VAR_VARIANTE] =
+        PlantillaTexto::formatear(variante, bufVariante);
+    plantilla.escribir(PlantillaExamen::ENCABEZADO, valores, examen);
+    plantilla.escribir(PlantillaExamen::ENCABEZADO_CLAVE, valores, clave);
+
+    for (std::size_t n = 0; n < orden.preguntas.size(); ++n) {
+      std::size_t indice = orden.preguntas[n];
+      const auto &alternativas = orden.alternativas[indice];
+      int numero = static_cast<int>(n) + 1;
+      preguntas[indice]->renderizar(plantilla, numero, alternativas, examen);
+
+      std::string respuesta = preguntas[indice]->getRespuesta(alternativas);
+      valores[PlantillaTexto::VAR_NUMERO] =
+          PlantillaTexto::formatear(numero, bufNumero);
+      valores[PlantillaTexto::VAR_RESPUESTA] = respuesta;
+      plantilla.escribir(PlantillaExamen::FIN_PREGUNTA, valores, examen);
+      plantilla.escribir(PlantillaExamen::ITEM_CLAVE, valores, clave);
+    }
+    plantilla.escribir(PlantillaExamen::PIE, valores, examen);
+    plantilla.escribir(PlantillaExamen::PIE_CLAVE, valores, clave);
+  }
+
+  // Método para renderizar una variante por estudiante. Las preguntas no
+  // deben modificarse mientras dura el renderizado
+  static void renderizarLote(const std::vector<const Pregunta *> &preguntas,
+                             const PlantillaExamen &plantilla,
+                             const std::string &titulo,
+                             const std::vector<std::string> &estudiantes,
+                             std::uint64_t semilla, const Destino &destino) {
+    PoolHilos::global().paraCadaBloque(
+        estudiantes.size(), 64,
+        [&](std::size_t, std::size_t inicio, std::size_t fin) {
+          std::string examen, clave;
+          OrdenVariante orden;
+          for (std::size_t i = inicio; i < fin; ++i) {
+            generarOrden(preguntas, semillaVariante(semilla, i), orden);
+            renderizarVariante(preguntas, orden, plantilla, titulo,
+                               estudiantes[i], static_cast<int>(i) + 1, examen,
+                               clave);
+            destino(i, examen, clave);
+          }
+        });
+  }
+};
+
+// Gestor de Preguntas Particionado - Reparte el banco en particiones según una
+// clave configurable (por defecto el año). Cada partición mantiene sus propios
+// índices y las búsquedas se ejecutan en paralelo sobre todas las particiones
+// (scatter-gather) usando un pool de hilos. Las preguntas guardadas son
+// inmutables y se comparten: lo que devuelven las consultas sigue siendo
+// válido aunque otro hilo actualice o elimine la pregunta después.
+class GestorPreguntasParticionado {
+public:
+  using ClaveParticion = std::function<int(const Pregunta &)>;
+  using PreguntaCompartida = std::shared_ptr<const Pregunta>;
+
+private:
+  // Partición - Preguntas de una misma clave con sus índices locales
+  struct Particion {
+    std::vector<PreguntaCompartida> preguntas; // Ordenadas por ID
+    std::array<std::vector<PreguntaCompartida>, CREAR + 1>
+        porNivelBloom; // Índice por nivel de Bloom (ordenado por ID)
+    std::map<int, int> preguntasPorAnio; // Año -> cantidad (para enrutar)
+    int tiempoTotal = 0; // Suma de tiempos estimados de la partición
+  };
+
+  PoolHilos &pool;
+  ClaveParticion clave;
+  bool claveEsAnio; // Permite enrutar las búsquedas por año
+  std::map<int, std::unique_ptr<Particion>> particiones;
+  std::unordered_map<int, int> particionPorId; // ID -> clave
+  // Índice para validación de preguntas repetidas: hash del texto -> IDs,
+  // como en GestorPreguntas. No guarda copias de los textos
+  std::unordered_multimap<std::size_t, int> idsPorHashTexto;
+  int siguienteId = 1;
+  mutable std::shared_mutex mutex; // Lecturas en paralelo, escrituras solas
+
+  static int idDe(const PreguntaCompartida &p) { return p->getId(); }
+
+  // Las particiones indexan por nivel de Bloom: solo se aceptan
+  // preguntas con un nivel entre RECORDAR y CREAR
+  static bool esAceptable(const Pregunta *p) {
+    return p && p->getNivelBloom() >= RECORDAR && p->getNivelBloom() <= CREAR;
+  }
+
+  // Hash del texto de una pregunta para el índice de repetidas
+  static std::size_t hashTexto(const Pregunta &p) {
+    return std::hash<std::string_view>{}(p.getTextoGuardado());
+  }
+
+  // Particiones con alguna pregunta de 'anio'. Si la clave es el año solo
+  // puede ser una; en otro caso se revisan todas
+  std::vector<const Particion *> particionesConAnio(int anio) const {
+    std::vector<const Particion *> resultado;
+    if (claveEsAnio) {
+      auto it = particiones.find(anio);
+      if (it != particiones.end()) {
+        resultado.push_back(it->second.get());
+      }
+    } else {
+      for (const auto &[c, particion] : particiones) {
+        if (particion->preguntasPorAnio.count(anio) > 0) {
+          resultado.push_back(particion.get());
+        }
+      }
+    }
+    return resultado;
+  }
+
+  // Busca una pregunta por ID (el llamador tiene tomado el mutex)
+  PreguntaCompartida buscarPorId(int id) const {
+    auto itClave = particionPorId.find(id);
+    if (itClave == particionPorId.end()) {
+      return nullptr;
+    }
+    const auto &lista = particiones.at(itClave->second)->preguntas;
+    return *std::ranges::lower_bound(lista, id, {}, idDe);
+  }
+
+  // Verifica si una pregunta es similar a otra existente. Misma regla que
+  // GestorPreguntas: cualquier texto igual cuenta como repetido, así que
+  // basta con el índice global por hash. Los choques de hash se resuelven
+  // comparando los textos
+  bool esPreguntaSimilar(const Pregunta &pregunta) const {
+    auto [desde, hasta] = idsPorHashTexto.equal_range(hashTexto(pregunta));
+    for (auto it = desde; it != hasta; ++it) {
+      PreguntaCompartida otra = buscarPorId(it->second);
+      if (otra && otra->getTextoGuardado() == pregunta.getTextoGuardado()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Inserta una pregunta (con ID ya asignado y nivel de Bloom válido) en su
+  // partición
+  void insertar(const PreguntaCompartida &p) {
+    int c = clave(*p);
+    auto &particion = particiones[c];
+    if (!particion) {
+      particion = std::make_unique<Particion>();
+    }
+
+    auto &porNivel = particion->porNivelBloom[p->getNivelBloom()];
+    porNivel.insert(std::ranges::upper_bound(porNivel, p->getId(), {}, idDe),
+                    p);
+    if (p->getAnio() > 0) {
+      particion->preguntasPorAnio[p->getAnio()]++;
+    }
+    particion->tiempoTotal += p->getTiempoEstimado();
+    auto pos = std::ranges::upper_bound(particion->preguntas, p->getId(), {},
+                                        idDe);
+    particion->preguntas.insert(pos, p);
+
+    particionPorId[p->getId()] = c;
+    idsPorHashTexto.emplace(hashTexto(*p), p->getId());
+  }
+
+  // Quita una pregunta de su partición y la devuelve
+  PreguntaCompartida extraer(int id) {
+    auto itClave = particionPorId.find(id);
+    if (itClave == particionPorId.end()) {
+      return nullptr;
+    }
+    auto itParticion = particiones.find(itClave->second);
+    Particion &particion = *itParticion->second;
+
+    auto pos = std::ranges::lower_bound(particion.preguntas, id, {}, idDe);
+    PreguntaCompartida pregunta = std::move(*pos);
+    particion.preguntas.erase(pos);
+
+    auto &porNivel = particion.porNivelBloom[pregunta->getNivelBloom()];
+    porNivel.erase(std::ranges::lower_bound(porNivel, id, {}, idDe));
+    auto itAnio = particion.preguntasPorAnio.find(pregunta->getAnio());
+    if (itAnio != particion.preguntasPorAnio.end() && --itAnio->second == 0) {
+      particion.preguntasPorAnio.erase(itAnio);
+    }
+    particion.tiempoTotal -= pregunta->getTiempoEstimado();
+    if (particion.preguntas.empty()) {
+      particiones.erase(itParticion);
+    }
+
+    particionPorId.erase(itClave);
+    auto [desde, hasta] = idsPorHashTexto.equal_range(hashTexto(*pregunta));
+    for (auto it = desde; it != hasta; ++it) {
+      if (it->second == id) {
+        idsPorHashTexto.erase(it);
+        break;
+      }
+    }
+    return pregunta;
+  }
+
+  // Ejecuta una función sobre cada partición en paralelo y devuelve los
+  // resultados en el orden de las claves de partición
+  template <typename Funcion>
+  auto dispersar(const std::vector<const Particion *> &destino,
+                 Funcion funcion) const {
+    using Resultado = std::invoke_result_t<Funcion, const Particion &>;
+    std::vector<std::future<Resultado>> futuros;
+    futuros.reserve(destino.size());
+    for (const Particion *particion : destino) {
+      futuros.push_back(
+          pool.enviar([&funcion, particion] { return funcion(*particion); }));
+    }
+    std::vector<Resultado> resultados;
+    resultados.reserve(futuros.size());
+    for (auto &futuro : futuros) {
+      resultados.push_back(pool.esperar(futuro));
+    }
+    return resultados;
+  }
+
+  std::vector<const Particion *> todasLasParticiones() const {
+    std::vector<const Particion *> resultado;
+    for (const auto &[c, particion] : particiones) {
+      resultado.push_back(particion.get());
+    }
+    return resultado;
+  }
+
+  // Une las listas parciales (cada una ordenada por ID) manteniendo el
+  // orden. Es una mezcla de k vías: un montículo con la primera pregunta
+  // pendiente de cada parte entrega el menor ID en O(log k)
+  static std::vector<PreguntaCompartida>
+  unir(std::vector<std::vector<PreguntaCompartida>> partes) {
+    using Cabeza = std::pair<int, std::size_t>; // (ID, parte)
+    std::vector<Cabeza> monticulo;
+    std::vector<std::size_t> posicion(partes.size(), 0);
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < partes.size(); ++i) {
+      total += partes[i].size();
+      if (!partes[i].empty()) {
+        monticulo.push_back({partes[i].front()->getId(), i});
+      }
+    }
+    std::ranges::make_heap(monticulo, std::greater<>());
+
+    std::vector<PreguntaCompartida> resultado;
+    resultado.reserve(total);
+    while (!monticulo.empty()) {
+      std::ranges::pop_heap(monticulo, std::greater<>());
+      std::size_t i = monticulo.back().second;
+      auto &parte = partes[i];
+      resultado.push_back(std::move(parte[posicion[i]++]));
+      if (posicion[i] < parte.size()) {
+        monticulo.back() = {parte[posicion[i]]->getId(), i};
+        std::ranges::push_heap(monticulo, std::greater<>());
+      } else {
+        monticulo.pop_back();
+      }
+    }
+    return resultado;
+  }
+
+public:
+  // Constructor - Particiona por año
+  explicit GestorPreguntasParticionado(PoolHilos &pool)
+      : pool(pool), clave([](const Pregunta &p) { return p.getAnio(); }),
+        claveEsAnio(true) {}
+
+  // Constructor - Particiona con una clave arbitraria (p. ej. un curso)
+  GestorPreguntasParticionado(PoolHilos &pool, ClaveParticion clave)
+      : pool(pool), clave(std::move(clave)), claveEsAnio(false) {}
+
+  // Método para agregar una pregunta con validación. Devuelve -1 si es
+  // similar a otra existente o si su nivel de Bloom no es válido
+  int agregarPregunta(std::unique_ptr<Pregunta> pregunta) {
+    if (!esAceptable(pregunta.get())) {
+      return -1;
+    }
+    std::unique_lock lock(mutex);
+    if (esPreguntaSimilar(*pregunta)) {
+      return -1; // Indica que la pregunta es similar a otra existente
+    }
+    int id = siguienteId++;
+    pregunta->setId(id);
+    insertar(std::move(pregunta));
+    return id;
+  }
+
+  // Método para actualizar una pregunta (puede cambiar de partición)
+  bool actualizarPregunta(int id,
+                          std::unique_ptr<Pregunta> preguntaActualizada) {
+    if (!esAceptable(preguntaActualizada.get())) {
+      return false;
+    }
+    std::unique_lock lock(mutex);
+    PreguntaCompartida anterior = extraer(id);
+    if (!anterior) {
+      return false;
+    }
+    if (esPreguntaSimilar(*preguntaActualizada)) {
+      insertar(anterior); // Mantener la versión anterior
+      return false;
+    }
+    preguntaActualizada->setId(id);
+    insertar(std::move(preguntaActualizada));
+    return true;
+  }
+
+  // Método para eliminar una pregunta
+  bool eliminarPregunta(int id) {
+    std::unique_lock lock(mutex);
+    return extraer(id) != nullptr;
+  }
+
+  // Método para obtener una pregunta por su ID. La pregunta devuelta es una
+  // instantánea: no cambia aunque después se actualice en el gestor
+  PreguntaCompartida getPregunta(int id) const {
+    std::shared_lock lock(mutex);
+    return buscarPorId(id);
+  }
+
+  // Método para buscar preguntas por nivel de Bloom en todas las particiones
+  std::vector<PreguntaCompartida> buscarPorNivelBloom(int nivel) const {
+    if (nivel < RECORDAR || nivel > CREAR) {
+      return {};
+    }
+    std::shared_lock lock(mutex);
+    return unir(dispersar(todasLasParticiones(), [nivel](const Particion &p) {
+      return p.porNivelBloom[nivel];
+    }));
+  }
+
+  // Método para buscar preguntas por año (solo en las particiones que
+  // pueden contener ese año)
+  std::vector<PreguntaCompartida> buscarPorAnio(int anio) const {
+    std::shared_lock lock(mutex);
+    std::vector<const Particion *> destino =
+        (claveEsAnio || anio > 0) ? particionesConAnio(anio)
+                                  : todasLasParticiones();
+    return unir(dispersar(destino, [anio](const Particion &p) {
+      std::vector<PreguntaCompartida> resultado;
+      for (const auto &q : p.preguntas) {
+        if (q->getAnio() == anio) {
+          resultado.push_back(q);
+        }
+      }
+      return resultado;
+    }));
+  }
+
+  // Método para contar preguntas de un nivel de Bloom
+  std::size_t contarPorNivelBloom(int nivel) const {
+    if (nivel < RECORDAR || nivel > CREAR) {
+      return 0;
+    }
+    std::shared_lock lock(mutex);
+    std::size_t total = 0;
+    for (std::size_t parcial :
+         dispersar(todasLasParticiones(), [nivel](const Particion &p) {
+           return p.porNivelBloom[nivel].size();
+         })) {
+      total += parcial;
+    }
+    return total;
+  }
+
+  // Método para calcular el tiempo total estimado
+  int calcularTiempoTotal() const {
+    std::shared_lock lock(mutex);
+    int total = 0;
+    for (const auto &[c, particion] : particiones) {
+      total += particion->tiempoTotal;
+    }
+    return total;
+  }
+
+  // Getters
+  std::size_t getCantidadPreguntas() const {
+    std::shared_lock lock(mutex);
+    return particionPorId.size();
+  }
+  std::size_t getCantidadParticiones() const {
+    std::shared_lock lock(mutex);
+    return particiones.size();
+  }
+};
+
+// Pruebas de Rendimiento - Cargas sintéticas para medir los subsistemas
+// concurrentes desde la línea de comandos.
+class PruebasRendimiento {
+public:
+  struct ResultadoContencion {
+    std::size_t lecturas = 0;       // Búsquedas y consultas por ID
+    std::size_t escrituras = 0;     // Altas, actualizaciones y bajas
+    std::size_t inconsistencias = 0; // Resultados desordenados o erróneos
+    double segundos = 0.0;
+  };
+
+  // Método para llenar un gestor particionado con preguntas sintéticas
+  static void poblar(GestorPreguntasParticionado &gestor, int cantidad) {
+    for (int i = 0; i < cantidad; ++i) {
+      gestor.agregarPregunta(std::make_unique<PreguntaVerdaderoFalso>(
+          0, "Pregunta sintética " + std::to_string(i), RECORDAR + i % 6,
+          1 + i % 10, i % 2 == 0, 2015 + i % 10));
+    }
+  }
+
+  // Método para ejecutar lectores y escritores a la vez sobre un gestor
+  // particionado. Los lectores validan cada resultado mientras los
+  // escritores agregan, mueven de partición y eliminan preguntas
+  static ResultadoContencion
+  medirContencion(GestorPreguntasParticionado &gestor, int lectores,
+                  int escritores, int operaciones) {
+    std::atomic<std::size_t> lecturas{0}, escrituras{0}, inconsistencias{0};
+    auto leer = [&](int hilo) {
+      std::mt19937 generador(hilo);
+      for (int k = 0; k < operaciones; ++k) {
+        int nivel = RECORDAR + static_cast<int>(generador() % 6);
+        auto resultado = k % 2 == 0
+                             ? gestor.buscarPorNivelBloom(nivel)
+                             : gestor.buscarPorAnio(2015 + nivel);
+        bool ordenado = std::ranges::is_sorted(
+            resultado, {}, [](const auto &p) { return p->getId(); });
+        bool nivelCorrecto = k % 2 == 1 || std::ranges::all_of(
+            resultado, [nivel](const auto &p) {
+              return p->getNivelBloom() == nivel;
+            });
+        if (!ordenado || !nivelCorrecto) {
+          inconsistencias++;
+        }
+        if (!resultado.empty()) {
+          // La instantánea sigue siendo válida aunque cambie el gestor
+          auto pregunta = gestor.getPregunta(resultado.front()->getId());
+          if (pregunta && pregunta->getTexto().empty()) {
+            inconsistencias++;
+          }
+        }
+        lecturas++;
+      }
+    };
+    auto escribir = [&](int hilo) {
+      for (int k = 0; k < operaciones; ++k) {
+        std::string texto = "Escritor " + std::to_string(hilo) + " - " +
+                            std::to_string(k);
+        int id = gestor.agregarPregunta(
+            std::make_unique<PreguntaVerdaderoFalso>(
+                0, texto, RECORDAR + k % 6, 1, true, 2015 + k % 10));
+        if (id > 0) {
+          gestor.actualizarPregunta(
+              id, std::make_unique<PreguntaVerdaderoFalso>(
+                      0, texto + " (editada)", CREAR - k % 6, 1, false,
+                      2016 + k % 10));
+          gestor.eliminarPregunta(id);
+        }
+        escrituras += 3;
+      }
+    };
+
+    auto inicio = std::chrono::steady_clock::now();
+    std::vector<std::thread> hilos;
+    for (int i = 0; i < lectores; ++i) {
+      hilos.emplace_back(leer, i);
+    }
+    for (int i = 0; i < escritores; ++i) {
+      hilos.emplace_back(escribir, i);
+    }
+    for (auto &hilo : hilos) {
+      hilo.join();
+    }
+    auto fin = std::chrono::steady_clock::now();
+
+    ResultadoContencion resultado;
+    resultado.lecturas = lecturas;
+    resultado.escrituras = escrituras;
+    resultado.inconsistencias = inconsistencias;
+    resultado.segundos = std::chrono::duration<double>(fin - inicio).count();
+    return resultado;
+  }
+
+  // Fila sintética para medir el escaneo paralelo
+  struct FilaSintetica {
+    int nivelBloom;
+    int anio;
+    int tiempoEstimado;
+  };
+
+  // Método para medir cuántos segundos tarda un escaneo (filtro y suma) de
+  // 'filas' con 'hilos' hilos. Con 0 hilos el escaneo es secuencial. En
+  // 'control' deja un resumen de los resultados para compararlos
+  static double medirEscaneo(const std::vector<FilaSintetica> &filas,
+                             std::size_t hilos, int repeticiones,
+                             long long &control) {
+    PoolHilos pool(std::max<std::size_t>(1, hilos));
+    MotorEscaneoParalelo motor(
+        &pool, hilos == 0 ? std::numeric_limits<std::size_t>::max() : 1);
+    control = 0;
+    auto inicio = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeticiones; ++r) {
+      auto elegidas = motor.filtrar(
+          filas,
+          [](const FilaSintetica &f) {
+            return f.nivelBloom == ANALIZAR && f.anio >= 2020;
+          },
+          [](const FilaSintetica &f) { return f.tiempoEstimado; });
+      long long tiempo = motor.reducir(
+          filas, 0LL,
+          [](const FilaSintetica &f) -> long long {
+            return f.tiempoEstimado;
+          },
+          std::plus<long long>());
+      control += static_cast<long long>(elegidas.size()) + tiempo;
+    }
+    auto fin = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(fin - inicio).count() / repeticiones;
+  }
+
+  // Método para leer argumentos numéricos positivos a partir de args[1].
+  // Deja los valores por defecto de los que faltan; false si alguno no es
+  // válido o sobran argumentos
+  static bool leerValores(const std::vector<std::string> &args,
+                          std::vector<int> &valores) {
+    if (args.size() > valores.size() + 1) {
+      return false;
+    }
+    for (std::size_t i = 1; i < args.size(); ++i) {
+      int valor = 0;
+      auto [fin, error] = std::from_chars(
+          args[i].data(), args[i].data() + args[i].size(), valor);
+      if (error != std::errc() || fin != args[i].data() + args[i].size() ||
+          valor <= 0) {
+        return false;
+      }
+      valores[i - 1] = valor;
+    }
+    return true;
+  }
+
+  // Método para ejecutar el escaneo de 10^7 filas (o 'cantidad') con 1, 2,
+  // 4... hasta 'hilos' hilos y mostrar la aceleración sobre el secuencial
+  static int ejecutarEscaneo(int cantidad, int hilos) {
+    std::vector<FilaSintetica> filas(cantidad);
+    std::mt19937 generador(42);
+    for (auto &fila : filas) {
+      fila = {RECORDAR + static_cast<int>(generador() % 6),
+              2010 + static_cast<int>(generador() % 15),
+              1 + static_cast<int>(generador() % 60)};
+    }
+    std::vector<int> configuraciones;
+    for (int h = 1; h < hilos; h *= 2) {
+      configuraciones.push_back(h);
+    }
+    configuraciones.push_back(hilos);
+
+    const int repeticiones = 5;
+    long long esperado = 0, control = 0;
+    double secuencial = medirEscaneo(filas, 0, repeticiones, esperado);
+    std::cout << "Filas: " << cantidad << "\nSecuencial: "
+              << secuencial * 1000 << " ms\n";
+    for (int h : configuraciones) {
+      double paralelo = medirEscaneo(filas, h, repeticiones, control);
+      std::cout << h << " hilo" << (h != 1 ? "s" : "") << ": "
+                << paralelo * 1000 << " ms (aceleración "
+                << secuencial / paralelo << "x)\n";
+      if (control != esperado) {
+        std::cout << "Error: El escaneo paralelo no coincide con el "
+                     "secuencial.\n";
+        return 1;
+      }
+    }
+    return 0;
+  }
+
+  // Método para ejecutar las pruebas desde la línea de comandos:
+  //   --bench-particionado [preguntas] [lectores] [escritores]
+  //   --bench-escaneo [filas] [hilos]
+  static int ejecutar(const std::vector<std::string> &args) {
+    if (!args.empty() && args[0] == "--bench-escaneo") {
+      std::vector<int> valores{
+          10000000, static_cast<int>(std::max(
+                        1u, std::thread::hardware_concurrency()))};
+      if (!leerValores(args, valores)) {
+        std::cout << "Uso:\n  --bench-escaneo [filas] [hilos]\n";
+        return 1;
+      }
+      return ejecutarEscaneo(valores[0], valores[1]);
+    }
+
+    std::vector<int> valores{100000, 8, 2}; // Valores por defecto
+    if (args.empty() || args[0] != "--bench-particionado" ||
+        !leerValores(args, valores)) {
+      std::cout << "Uso:\n  --bench-particionado [preguntas] [lectores] "
+                   "[escritores]\n  --bench-escaneo [filas] [hilos]\n";
+      return 1;
+    }
+
+    GestorPreguntasParticionado gestor(PoolHilos::global());
+    poblar(gestor, valores[0]);
+    ResultadoContencion resultado =
+        medirContencion(gestor, valores[1], valores[2], 200);
+    std::cout << "Preguntas: " << gestor.getCantidadPreguntas() << " en "
+              << gestor.getCantidadParticiones() << " particiones\n"
+              << "Lecturas: " << resultado.lecturas
+              << ", escrituras: " << resultado.escrituras << " en "
+              << resultado.segundos << " s ("
+              << (resultado.lecturas + resultado.escrituras) /
+                     std::max(resultado.segundos, 1e-9)
+              << " operaciones/s)\n"
+              << "Inconsistencias: " << resultado.inconsistencias << "\n";
+    return resultado.inconsistencias == 0 ? 0 : 1;
+  }
+};
+
+// Modelo de respuesta al ítem (IRT) logístico de dos parámetros. Con
+// discriminación 1 en todas las preguntas equivale al modelo de Rasch (1PL).
+struct ModeloIRT {
+  // Probabilidad de acertar con habilidad 'theta'
+  static double probabilidadAcierto(double theta, double discriminacion,
+                                    double dificultad) {
+    return 1.0 / (1.0 + std::exp(-discriminacion * (theta - dificultad)));
+  }
+
+  // Información de Fisher que aporta la pregunta con habilidad 'theta'
+  static double informacion(double theta, double discriminacion,
+                            double dificultad) {
+    double p = probabilidadAcierto(theta, discriminacion, dificultad);
+    return discriminacion * discriminacion * p * (1.0 - p);
+  }
+
+  // Cota superior de la información de cualquier pregunta con discriminación
+  // <= aMax cuya dificultad esté a distancia 'distancia' de theta. Se usa
+  // u^2 p(u) (1 - p(u)), que crece hasta u ~= 2.3994 y luego decrece.
+  static double cotaInformacion(double aMax, double distancia) {
+    if (distancia <= 0.0) {
+      return aMax * aMax / 4.0;
+    }
+    double u = std::min(aMax * distancia, 2.3994);
+    double p = 1.0 / (1.0 + std::exp(-u));
+    return u * u * p * (1.0 - p) / (distancia * distancia);
+  }
+};
+
+// Índice inmutable de preguntas para tests adaptativos. Agrupa las preguntas
+// por nivel de Bloom y por rango de discriminación, y ordena cada grupo por
+// dificultad. Como la información de una pregunta disminuye al alejarse su
+// dificultad de theta, la siguiente pregunta se busca hacia ambos lados de
+// theta y la búsqueda se corta en cuanto la cota no puede mejorar la mejor
+// encontrada. Así no se recorre el banco completo.
+class IndiceItemsIRT {
+public:
+  // Datos de una pregunta necesarios para seleccionarla
+  struct Item {
+    int id;
+    double discriminacion;
+    double dificultad;
+    int tiempoEstimado;
+    int grupoTematico;
+  };
+
+  // Grupo de preguntas de un nivel con discriminación parecida
+  struct Grupo {
+    double discriminacionMaxima = 0.0;
+    std::size_t primerOrdinal = 0; // Ordinal global del primer ítem
+    std::vector<Item> items;       // Ordenados por dificultad
+  };
+
+private:
+  static constexpr double ANCHO_GRUPO = 0.25; // Rango de discriminación
+  std::array<std::vector<Grupo>, CREAR + 1> porNivel; // Grupos por nivel
+  std::size_t cantidadItems = 0;
+
+public:
+  // Constructor - Toma los parámetros de cada pregunta del rango (de
+  // elementos const Pregunta &, como las vistas del gestor)
+  template <typename RangoPreguntas>
+  explicit IndiceItemsIRT(RangoPreguntas &&preguntas) {
+    std::array<std::map<int, Grupo>, CREAR + 1> agrupados;
+    for (const Pregunta &p : preguntas) {
+      int nivel = p.getNivelBloom();
+      double a = p.getDiscriminacion();
+      if (nivel < RECORDAR || nivel > CREAR || !(a > 0.0)) {
+        continue; // Sin parámetros válidos no se puede seleccionar
+      }
+      Grupo &grupo = agrupados[nivel][static_cast<int>(a / ANCHO_GRUPO)];
+      grupo.discriminacionMaxima = std::max(grupo.discriminacionMaxima, a);
+      grupo.items.push_back({p.getId(), a, p.getDificultad(),
+                             p.getTiempoEstimado(), p.getGrupoTematico()});
+    }
+
+    for (int nivel = RECORDAR; nivel <= CREAR; ++nivel) {
+      // Los grupos más discriminantes primero: son los de mayor cota
+      for (auto it = agrupados[nivel].rbegin(); it != agrupados[nivel].rend();
+           ++it) {
+        Grupo &grupo = it->second;
+        std::ranges::sort(grupo.items, {}, &Item::dificultad);
+        grupo.primerOrdinal = cantidadItems;
+        cantidadItems += grupo.items.size();
+        porNivel[nivel].push_back(std::move(grupo));
+      }
+    }
+  }
+
+  // Método para elegir la pregunta no usada con mayor información en theta,
+  // dentro de los niveles permitidos (máscara de bits por nivel), del
+  // tiempo disponible y, opcionalmente, del máximo de preguntas por grupo
+  // temático. Devuelve nullptr si ninguna pregunta cumple
+  const Item *
+  seleccionar(double theta, unsigned nivelesPermitidos, int tiempoDisponible,
+              const std::unordered_set<std::size_t> &usados,
+              std::size_t *ordinal = nullptr,
+              const std::unordered_map<int, int> *usoPorGrupo = nullptr,
+              int maxPorGrupo = std::numeric_limits<int>::max()) const {
+    const Item *mejor = nullptr;
+    double mejorInformacion = -1.0;
+
+    for (int nivel = RECORDAR; nivel <= CREAR; ++nivel) {
+      if (!(nivelesPermitidos & (1u << nivel))) {
+        continue;
+      }
+      for (const Grupo &grupo : porNivel[nivel]) {
+        double aMax = grupo.discriminacionMaxima;
+        if (aMax * aMax / 4.0 <= mejorInformacion) {
+          break; // Los grupos siguientes tienen cotas aún menores
+        }
+
+        const auto &items = grupo.items;
+        std::size_t derecha =
+            std::ranges::lower_bound(items, theta, {}, &Item::dificultad) -
+            items.begin();
+        std::size_t izquierda = derecha; // Siguiente candidato: izquierda - 1
+
+        // Recorre los candidatos en orden de distancia creciente a theta
+        while (izquierda > 0 || derecha < items.size()) {
+          bool tomarIzquierda =
+              derecha >= items.size() ||
+              (izquierda > 0 && theta - items[izquierda - 1].dificultad <
+                                    items[derecha].dificultad - theta);
+          std::size_t i = tomarIzquierda ? izquierda - 1 : derecha;
+          double distancia = std::abs(items[i].dificultad - theta);
+          if (ModeloIRT::cotaInformacion(aMax, distancia) <= mejorInformacion) {
+            break;
+          }
+
+          const Item &item = items[i];
+          bool grupoLleno = false;
+          if (usoPorGrupo && item.grupoTematico >= 0) {
+            auto uso = usoPorGrupo->find(item.grupoTematico);
+            grupoLleno =
+                uso != usoPorGrupo->end() && uso->second >= maxPorGrupo;
+          }
+          if (item.tiempoEstimado <= tiempoDisponible && !grupoLleno &&
+              usados.count(grupo.primerOrdinal + i) == 0) {
+            double info = ModeloIRT::informacion(theta, item.discriminacion,
+                                                 item.dificultad);
+            if (info > mejorInformacion) {
+              mejorInformacion = info;
+              mejor = &item;
+              if (ordinal) {
+                *ordinal = grupo.primerOrdinal + i;
+              }
+            }
+          }
+
+          if (tomarIzquierda) {
+            --izquierda;
+          } else {
+            ++derecha;
+          }
+        }
+      }
+    }
+    return mejor;
+  }
+
+  std::size_t getCantidadItems() const { return cantidadItems; }
+};
+
+// Restricciones de un test adaptativo
+struct RestriccionesTest {
+  unsigned nivelesBloom = 0x7E; // Bits 1-6: niveles de Bloom permitidos
+  int tiempoMaximo = std::numeric_limits<int>::max(); // En minutos
+  int maxPreguntas = 30;
+  double errorObjetivo = 0.0; // Termina cuando el error estándar baja de esto
+  int maxPorGrupoTematico =
+      std::numeric_limits<int>::max(); // Cobertura: máximo por tema
+};
+
+// Sesión de test adaptativo de un estudiante. Estima la habilidad (theta) por
+// EAP sobre una grilla con prior normal estándar y, tras cada respuesta,
+// elige la pregunta de mayor información en la estimación actual. Cada
+// sesión es independiente: muchas sesiones pueden avanzar en paralelo
+// compartiendo el mismo índice.
+class SesionAdaptativa {
+private:
+  static constexpr int PUNTOS_GRILLA = 81;
+  static constexpr double THETA_MIN = -4.0;
+  static constexpr double THETA_MAX = 4.0;
+
+  std::shared_ptr<const IndiceItemsIRT> indice;
+  RestriccionesTest restricciones;
+  std::unordered_set<std::size_t> usados; // Ordinales ya presentados
+  std::unordered_map<int, int> usoPorGrupo; // Preguntas por grupo temático
+  std::array<double, PUNTOS_GRILLA> logPosterior;
+  double theta = 0.0;
+  double errorEstandar = 1.0;
+  int tiempoRestante;
+  const IndiceItemsIRT::Item *pendiente = nullptr; // Sin responder
+  std::vector<std::pair<int, bool>> respuestas;     // (ID, correcta)
+
+  static double puntoGrilla(int k) {
+    return THETA_MIN + (THETA_MAX - THETA_MIN) * k / (PUNTOS_GRILLA - 1);
+  }
+
+  // Recalcula theta y su error estándar a partir de la posterior
+  void actualizarEstimacion() {
+    double maximo = *std::ranges::max_element(logPosterior);
+    double suma = 0.0, media = 0.0, cuadrados = 0.0;
+    for (int k = 0; k < PUNTOS_GRILLA; ++k) {
+      double peso = std::exp(logPosterior[k] - maximo);
+      double t = puntoGrilla(k);
+      suma += peso;
+      media += peso * t;
+      cuadrados += peso * t * t;
+    }
+    theta = media / suma;
+    errorEstandar = std::sqrt(std::max(0.0, cuadrados / suma - theta * theta));
+  }
+
+public:
+  // Constructor
+  SesionAdaptativa(std::shared_ptr<const IndiceItemsIRT> indice,
+                   const RestriccionesTest &restricciones)
+      : indice(std::move(indice)), restricciones(restricciones),
+        tiempoRestante(restricciones.tiempoMaximo) {
+    for (int k = 0; k < PUNTOS_GRILLA; ++k) {
+      double t = puntoGrilla(k);
+      logPosterior[k] = -0.5 * t * t; // Prior normal estándar
+    }
+    actualizarEstimacion();
+  }
+
+  // Método para obtener la siguiente pregunta (ID) o -1 si el test terminó.
+  // Si la pregunta anterior no fue respondida se vuelve a entregar
+  int siguientePregunta() {
+    if (pendiente) {
+      return pendiente->id;
+    }
+    if (terminada()) {
+      return -1;
+    }
+    std::size_t ordinal = 0;
+    pendiente = indice->seleccionar(
+        theta, restricciones.nivelesBloom, tiempoRestante, usados, &ordinal,
+        &usoPorGrupo, restricciones.maxPorGrupoTematico);
+    if (!pendiente) {
+      return -1;
+    }
+    usados.insert(ordinal);
+    if (pendiente->grupoTematico >= 0) {
+      usoPorGrupo[pendiente->grupoTematico]++;
+    }
+    tiempoRestante -= pendiente->tiempoEstimado;
+    return pendiente->id;
+  }
+
+  // Método para registrar la respuesta a la pregunta entregada
+  bool registrarRespuesta(bool correcta) {
+    if (!pendiente) {
+      return false;
+    }
+    for (int k = 0; k < PUNTOS_GRILLA; ++k) {
+      double p = ModeloIRT::probabilidadAcierto(
+          puntoGrilla(k), pendiente->discriminacion, pendiente->dificultad);
+      logPosterior[k] += std::log(correcta ? p : 1.0 - p);
+    }
+    respuestas.emplace_back(pendiente->id, correcta);
+    pendiente = nullptr;
+    actualizarEstimacion();
+    return true;
+  }
+
+  // Indica si se alcanzó el máximo de preguntas o la precisión buscada
+  bool terminada() const {
+    return static_cast<int>(respuestas.size()) >= restricciones.maxPreguntas ||
+           errorEstandar < restricciones.errorObjetivo;
+  }
+
+  // Getters
+  double getTheta() const { return theta; }
+  double getErrorEstandar() const { return errorEstandar; }
+  int getTiempoRestante() const { return tiempoRestante; }
+  const std::vector<std::pair<int, bool>> &getRespuestas() const {
+    return respuestas;
+  }
+};
+
+// Motor de Tests Adaptativos - Mantiene el índice de selección del banco y
+// crea sesiones. Reconstruir el índice no afecta a las sesiones en curso,
+// que conservan el índice con el que empezaron.
+class MotorTestAdaptativo {
+private:
+  std::shared_ptr<const IndiceItemsIRT> indice;
+  mutable std::mutex mutex;
+
+public:
+  // Constructor - Construye el índice a partir del banco
+  explicit MotorTestAdaptativo(const GestorPreguntas &gestor) {
+    reconstruirIndice(gestor);
+  }
+
+  // Método para actualizar el índice tras cambios en el banco
+  void reconstruirIndice(const GestorPreguntas &gestor) {
+    auto nuevo =
+        std::make_shared<const IndiceItemsIRT>(gestor.vistaPreguntas());
+    std::lock_guard<std::mutex> lock(mutex);
+    indice = std::move(nuevo);
+  }
+
+  // Método para iniciar una sesión adaptativa
+  std::unique_ptr<SesionAdaptativa>
+  crearSesion(const RestriccionesTest &restricciones = {}) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::make_unique<SesionAdaptativa>(indice, restricciones);
+  }
+};
+
+// Calibrador IRT - Estima los parámetros de cada pregunta (discriminación y
+// dificultad del modelo de dos parámetros) a partir de respuestas de
+// estudiantes. Alterna pasos de Newton para la habilidad de cada estudiante
+// y de Fisher para los parámetros de cada pregunta (máxima verosimilitud
+// conjunta con priors débiles, que mantienen finitas las estimaciones de
+// quien acierta o falla todo). Las habilidades se estandarizan en cada
+// iteración para fijar la escala.
+class CalibradorIRT {
+private:
+  struct Observacion {
+    int estudiante; // Índice del estudiante
+    int item;       // Índice de la pregunta
+    bool correcta;
+  };
+
+  std::unordered_map<std::string, int> indiceEstudiante;
+  std::unordered_map<int, int> indiceItem;
+  std::vector<int> idsItems; // ID de la pregunta de cada índice
+  std::vector<Observacion> observaciones;
+
+  static constexpr double A_MIN = 0.2, A_MAX = 4.0;
+  static constexpr double LIMITE = 4.0; // |theta| y |dificultad| máximos
+  // Priors: discriminación ~ N(1, 1), dificultad ~ N(0, 2^2), theta ~ N(0, 1)
+  static constexpr double PRECISION_A = 1.0, PRECISION_B = 0.25;
+
+public:
+  // Método para agregar una respuesta
+  void agregar(const RespuestaEstudiante &r) {
+    auto [estudiante, nuevoEstudiante] = indiceEstudiante.try_emplace(
+        r.estudiante, static_cast<int>(indiceEstudiante.size()));
+    auto [item, nuevoItem] = indiceItem.try_emplace(
+        r.preguntaId, static_cast<int>(idsItems.size()));
+    if (nuevoItem) {
+      idsItems.push_back(r.preguntaId);
+    }
+    observaciones.push_back({estudiante->second, item->second, r.correcta});
+  }
+
+  // Método para estimar los parámetros de las preguntas con al menos
+  // 'minimoRespuestas' respuestas. Devuelve pares (ID, parámetros), listos
+  // para GestorPreguntas::asignarParametrosIRT
+  std::vector<std::pair<int, ParametrosIRT>>
+  calibrar(int minimoRespuestas = 30, int iteraciones = 100) const {
+    std::size_t nItems = idsItems.size();
+    std::size_t nEstudiantes = indiceEstudiante.size();
+    std::vector<int> respuestasItem(nItems, 0), aciertosItem(nItems, 0);
+    for (const Observacion &o : observaciones) {
+      respuestasItem[o.item]++;
+      aciertosItem[o.item] += o.correcta ? 1 : 0;
+    }
+
+    // Inicio: discriminación 1 y dificultad según la proporción de aciertos
+    std::vector<double> a(nItems, 1.0), b(nItems, 0.0);
+    for (std::size_t i = 0; i < nItems; ++i) {
+      double p = (aciertosItem[i] + 0.5) / (respuestasItem[i] + 1.0);
+      b[i] = std::clamp(-std::log(p / (1.0 - p)), -LIMITE, LIMITE);
+    }
+    std::vector<double> theta(nEstudiantes, 0.0);
+
+    for (int iteracion = 0; iteracion < iteraciones; ++iteracion) {
+      // Paso de Newton para la habilidad de cada estudiante
+      std::vector<double> gradiente(nEstudiantes, 0.0);
+      std::vector<double> hessiano(nEstudiantes, 0.0);
+      for (const Observacion &o : observaciones) {
+        double p = ModeloIRT::probabilidadAcierto(theta[o.estudiante],
+                                                  a[o.item], b[o.item]);
+        gradiente[o.estudiante] += a[o.item] * ((o.correcta ? 1.0 : 0.0) - p);
+        hessiano[o.estudiante] += a[o.item] * a[o.item] * p * (1.0 - p);
+      }
+      double media = 0.0, cuadrados = 0.0;
+      for (std::size_t j = 0; j < nEstudiantes; ++j) {
+        theta[j] += (gradiente[j] - theta[j]) / (hessiano[j] + 1.0);
+        theta[j] = std::clamp(theta[j], -LIMITE, LIMITE);
+        media += theta[j];
+        cuadrados += theta[j] * theta[j];
+      }
+      if (nEstudiantes > 1) {
+        media /= nEstudiantes;
+        double desviacion =
+            std::sqrt(std::max(cuadrados / nEstudiantes - media * media, 0.0));
+        for (double &t : theta) {
+          t = desviacion > 0.0 ? (t - media) / desviacion : 0.0;
+        }
+      }
+
+      // Paso de Fisher para (discriminación, dificultad) de cada pregunta.
+      // Con z = a (theta - b): dL/da = sum r (theta - b), dL/db = -a sum r,
+      // donde r = x - p, e información I_aa = sum w (theta - b)^2,
+      // I_bb = a^2 sum w, I_ab = -a sum w (theta - b), con w = p (1 - p)
+      std::vector<double> gradA(nItems, 0.0), gradB(nItems, 0.0);
+      std::vector<double> infoAA(nItems, 0.0), infoBB(nItems, 0.0);
+      std::vector<double> cruzado(nItems, 0.0);
+      for (const Observacion &o : observaciones) {
+        double distancia = theta[o.estudiante] - b[o.item];
+        double p = ModeloIRT::probabilidadAcierto(theta[o.estudiante],
+                                                  a[o.item], b[o.item]);
+        double r = (o.correcta ? 1.0 : 0.0) - p, w = p * (1.0 - p);
+        gradA[o.item] += r * distancia;
+        gradB[o.item] += r;
+        infoAA[o.item] += w * distancia * distancia;
+        infoBB[o.item] += w;
+        cruzado[o.item] += w * distancia;
+      }
+      double cambioMaximo = 0.0;
+      for (std::size_t i = 0; i < nItems; ++i) {
+        double ga = gradA[i] - PRECISION_A * (a[i] - 1.0);
+        double gb = -a[i] * gradB[i] - PRECISION_B * b[i];
+        double iaa = infoAA[i] + PRECISION_A;
+        double ibb = a[i] * a[i] * infoBB[i] + PRECISION_B;
+        double iab = -a[i] * cruzado[i];
+        double determinante = iaa * ibb - iab * iab;
+        if (!(determinante > 0.0)) {
+          continue;
+        }
+        double da = (ibb * ga - iab * gb) / determinante;
+        double db = (iaa * gb - iab * ga) / determinante;
+        double nuevaA = std::clamp(a[i] + da, A_MIN, A_MAX);
+        double nuevaB = std::clamp(b[i] + db, -LIMITE, LIMITE);
+        cambioMaximo = std::max({cambioMaximo, std::abs(nuevaA - a[i]),
+                                 std::abs(nuevaB - b[i])});
+        a[i] = nuevaA;
+        b[i] = nuevaB;
+      }
+      if (cambioMaximo < 1e-4) {
+        break;
+      }
+    }
+
+    std::vector<std::pair<int, ParametrosIRT>> parametros;
+    for (std::size_t i = 0; i < nItems; ++i) {
+      if (respuestasItem[i] >= minimoRespuestas) {
+        parametros.push_back({idsItems[i], {a[i], b[i]}});
+      }
+    }
+    std::ranges::sort(parametros, {}, &std::pair<int, ParametrosIRT>::first);
+    return parametros;
+  }
+
+  std::size_t getCantidadRespuestas() const { return observaciones.size(); }
+  std::size_t getCantidadEstudiantes() const {
+    return indiceEstudiante.size();
+  }
+};
+
+// T-Digest - Resumen compacto de una distribución para estimar cuantiles.
+// Agrupa las observaciones en centroides: pocos y grandes en el centro de la
+// distribución, muchos y pequeños en las colas, donde se necesita precisión.
+// Ocupa memoria acotada por la compresión y dos digests se pueden fusionar.
+// No es seguro usar un mismo digest desde varios hilos a la vez.
+class TDigest {
+private:
+  struct Centroide {
+    double media;
+    double peso;
+  };
+
+  double compresion;
+  std::vector<Centroide> centroides; // Ordenados por media
+  std::vector<double> pendientes;    // Observaciones sin comprimir
+  std::vector<double> acumulado;     // Peso antes del centro de cada uno
+  double pesoTotal = 0.0;
+  double minimo = std::numeric_limits<double>::infinity();
+  double maximo = -std::numeric_limits<double>::infinity();
+
+  // Función de escala k1: limita el peso de cada centroide según su cuantil
+  double escala(double q) const {
+    return compresion / (2.0 * std::numbers::pi) * std::asin(2.0 * q - 1.0);
+  }
+  double escalaInversa(double k) const {
+    if (k >= compresion / 4.0) {
+      return 1.0;
+    }
+    return (std::sin(2.0 * std::numbers::pi * k / compresion) + 1.0) / 2.0;
+  }
+
+  // Reagrupa una lista de centroides respetando el peso máximo que permite
+  // la función de escala, y recalcula las posiciones acumuladas
+  void reagrupar(std::vector<Centroide> todos) {
+    std::ranges::sort(todos, {}, &Centroide::media);
+    centroides.clear();
+    double pesoAnterior = 0.0;
+    double limite = escalaInversa(escala(0.0) + 1.0);
+    Centroide actual = todos.front();
+    for (std::size_t i = 1; i < todos.size(); ++i) {
+      const Centroide &c = todos[i];
+      if ((pesoAnterior + actual.peso + c.peso) / pesoTotal <= limite) {
+        actual.media +=
+            (c.media - actual.media) * c.peso / (actual.peso + c.peso);
+        actual.peso += c.peso;
+      } else {
+        pesoAnterior += actual.peso;
+        centroides.push_back(actual);
+        limite = escalaInversa(escala(pesoAnterior / pesoTotal) + 1.0);
+        actual = c;
+      }
+    }
+    centroides.push_back(actual);
+
+    acumulado.resize(centroides.size());
+    double peso = 0.0;
+    for (std::size_t i = 0; i < centroides.size(); ++i) {
+      acumulado[i] = peso + centroides[i].peso / 2.0;
+      peso += centroides[i].peso;
+    }
+  }
+
+  // Cuantil q calculado solo con los centroides (sin pendientes)
+  double cuantilComprimido(double q) const {
+    if (centroides.empty()) {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+    q = std::clamp(q, 0.0, 1.0);
+    double indice = q * pesoTotal;
+
+    if (indice <= acumulado.front()) {
+      double fraccion = indice / acumulado.front();
+      return minimo + (centroides.front().media - minimo) * fraccion;
+    }
+    if (indice >= acumulado.back()) {
+      double resto = pesoTotal - acumulado.back();
+      double fraccion = resto > 0.0 ? (indice - acumulado.back()) / resto : 0.0;
+      return centroides.back().media +
+             (maximo - centroides.back().media) * fraccion;
+    }
+    std::size_t i = std::ranges::upper_bound(acumulado, indice) -
+                    acumulado.begin(); // acumulado[i-1] <= indice < [i]
+    double fraccion =
+        (indice - acumulado[i - 1]) / (acumulado[i] - acumulado[i - 1]);
+    return centroides[i - 1].media +
+           (centroides[i].media - centroides[i - 1].media) * fraccion;
+  }
+
+public:
+  // Constructor - Mayor compresión: más centroides y más precisión
+  explicit TDigest(double compresion = 100.0) : compresion(compresion) {}
+
+  // Método para agregar una observación
+  void agregar(double valor) {
+    pendientes.push_back(valor);
+    pesoTotal += 1.0;
+    minimo = std::min(minimo, valor);
+    maximo = std::max(maximo, valor);
+    if (pendientes.size() >= static_cast<std::size_t>(5 * compresion)) {
+      comprimir();
+    }
+  }
+
+  // Método para incorporar las observaciones pendientes a los centroides.
+  // Después, las consultas const no necesitan copiar el digest
+  void comprimir() {
+    if (pendientes.empty()) {
+      return;
+    }
+    std::vector<Centroide> todos = std::move(centroides);
+    for (double valor : pendientes) {
+      todos.push_back({valor, 1.0});
+    }
+    pendientes.clear();
+    reagrupar(std::move(todos));
+  }
+
+  // Método para fusionar otro digest en este (sin modificar el otro: sus
+  // observaciones pendientes entran como centroides de peso 1). Fusionar un
+  // digest consigo mismo no hace nada
+  void fusionar(const TDigest &otro) {
+    if (&otro == this || otro.pesoTotal == 0.0) {
+      return;
+    }
+    std::vector<Centroide> todos = std::move(centroides);
+    todos.insert(todos.end(), otro.centroides.begin(), otro.centroides.end());
+    for (double valor : otro.pendientes) {
+      todos.push_back({valor, 1.0});
+    }
+    for (double valor : pendientes) {
+      todos.push_back({valor, 1.0});
+    }
+    pendientes.clear();
+    pesoTotal += otro.pesoTotal;
+    minimo = std::min(minimo, otro.minimo);
+    maximo = std::max(maximo, otro.maximo);
+    reagrupar(std::move(todos));
+  }
+
+  // Método para estimar el valor bajo el cual cae la fracción q (0-1). No
+  // modifica el digest: si quedan observaciones pendientes calcula sobre una
+  // copia comprimida (conviene llamar a comprimir() antes de consultar)
+  double cuantil(double q) const {
+    if (pendientes.empty()) {
+      return cuantilComprimido(q);
+    }
+    TDigest copia = *this;
+    copia.comprimir();
+    return copia.cuantilComprimido(q);
+  }
+
+  // Getters
+  double getCantidad() const { return pesoTotal; }
+  bool estaComprimido() const { return pendientes.empty(); }
+  std::size_t getCantidadCentroides() const {
+    if (pendientes.empty()) {
+      return centroides.size();
+    }
+    TDigest copia = *this;
+    copia.comprimir();
+    return copia.centroides.size();
+  }
+};
+
+// Registro de Tiempos de Respuesta - Recibe los tiempos observados (en
+// minutos) de cada pregunta y mantiene un t-digest por pregunta. Para ingerir
+// desde varios hilos, cada hilo usa su propio registro y luego lo fusiona en
+// el registro compartido; fusionar cuesta según la cantidad de centroides y
+// no según la cantidad de observaciones. Las consultas copian los digests
+// que necesitan y calculan fuera del mutex.
+class RegistroTiemposRespuesta {
+private:
+  double compresion;
+  std::unordered_map<int, TDigest> digests; // ID de pregunta -> tiempos
+  mutable std::mutex mutex;
+
+public:
+  // Constructor
+  explicit RegistroTiemposRespuesta(double compresion = 100.0)
+      : compresion(compresion) {}
+
+  // Método para registrar un tiempo observado
+  void registrar(int idPregunta, double minutos) {
+    std::lock_guard<std::mutex> lock(mutex);
+    digests.try_emplace(idPregunta, compresion).first->second.agregar(minutos);
+  }
+
+  // Método para registrar el tiempo de una respuesta de estudiante (en
+  // segundos). Las respuestas sin tiempo (0 segundos) no se registran
+  bool registrar(const RespuestaEstudiante &respuesta) {
+    if (!(respuesta.segundos > 0.0)) {
+      return false;
+    }
+    registrar(respuesta.preguntaId, respuesta.segundos / 60.0);
+    return true;
+  }
+
+  // Método para registrar los tiempos de un archivo de respuestas. Devuelve
+  // la cantidad de tiempos registrados o -1 si no se pudo abrir
+  long long cargarRespuestas(const std::string &ruta) {
+    ArchivoRespuestas archivo(ruta);
+    if (!archivo.estaAbierto()) {
+      return -1;
+    }
+    RegistroTiemposRespuesta lote(compresion); // Sin tomar el mutex
+    long long registrados = 0;
+    RespuestaEstudiante respuesta;
+    while (archivo.siguiente(respuesta)) {
+      registrados += lote.registrar(respuesta) ? 1 : 0;
+    }
+    fusionar(lote);
+    return registrados;
+  }
+
+  // Método para fusionar los tiempos de otro registro en este. Los digests
+  // quedan comprimidos, listos para copiarse en las consultas. Fusionar un
+  // registro consigo mismo no hace nada (tomaría dos veces el mismo mutex)
+  void fusionar(const RegistroTiemposRespuesta &otro) {
+    if (&otro == this) {
+      return;
+    }
+    std::scoped_lock lock(mutex, otro.mutex);
+    for (const auto &[id, digest] : otro.digests) {
+      TDigest &propio = digests.try_emplace(id, compresion).first->second;
+      propio.fusionar(digest);
+      propio.comprimir();
+    }
+  }
+
+  // Método para obtener el cuantil q del tiempo de una pregunta. Sin
+  // observaciones se usa el tiempo estimado por el autor
+  double cuantil(const Pregunta &pregunta, double q) const {
+    std::optional<TDigest> copia;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto it = digests.find(pregunta.getId());
+      if (it != digests.end() && it->second.getCantidad() > 0.0) {
+        copia = it->second;
+      }
+    }
+    if (!copia) {
+      return pregunta.getTiempoEstimado();
+    }
+    copia->comprimir();
+    return copia->cuantil(q);
+  }
+
+  // Método para indicar si hay tiempos observados de alguna pregunta
+  bool tieneObservaciones() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return !digests.empty();
+  }
+
+  // Método para estimar en cuántos minutos termina el examen la fracción
+  // 'percentil' (0-1) de los estudiantes. Simula exámenes tomando para cada
+  // pregunta un tiempo al azar de su distribución observada (suponiendo
+  // independencia entre preguntas) y devuelve el cuantil de los totales
+  template <typename RangoPreguntas>
+  double estimarDuracionExamen(RangoPreguntas &&preguntas, double percentil,
+                               int simulaciones = 2000,
+                               unsigned semilla = 12345) const {
+    std::vector<TDigest> distribuciones;
+    double tiempoFijo = 0.0; // Preguntas sin observaciones
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (const Pregunta &p : preguntas) {
+        auto it = digests.find(p.getId());
+        if (it == digests.end() || it->second.getCantidad() == 0.0) {
+          tiempoFijo += p.getTiempoEstimado();
+        } else {
+          distribuciones.push_back(it->second);
+        }
+      }
+    }
+    if (distribuciones.empty() || simulaciones <= 0) {
+      return tiempoFijo;
+    }
+    for (TDigest &d : distribuciones) {
+      d.comprimir(); // La simulación consulta cada digest muchas veces
+    }
+
+    std::mt19937 generador(semilla);
+    std::uniform_real_distribution<double> uniforme(0.0, 1.0);
+    TDigest totales;
+    for (int s = 0; s < simulaciones; ++s) {
+      double total = tiempoFijo;
+      for (const TDigest &d : distribuciones) {
+        total += d.cuantil(uniforme(generador));
+      }
+      totales.agregar(total);
+    }
+    totales.comprimir();
+    return totales.cuantil(percentil);
+  }
+
+  // Getters
+  std::size_t getCantidadPreguntas() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return digests.size();
+  }
+};
+
+// Planificador de Repaso Espaciado - Modo práctica. Guarda, para cada par
+// estudiante×pregunta practicado, un estado SM-2 (intervalo, facilidad y
+// repeticiones) en 16 bytes, y por estudiante una cola de prioridad por
+// nivel de Bloom ordenada por fecha de vencimiento. Las fechas son días
+// enteros. Los pares que un estudiante nunca practicó no ocupan memoria.
+// Cada estado tiene una sola entrada vigente en las colas: la de su última
+// generación, en la cola del nivel actual de la pregunta.
+class PlanificadorRepaso {
+public:
+  // Resultado de un repaso: calidad de 0 (olvido total) a 5 (perfecto)
+  struct Revision {
+    int estudiante;
+    int pregunta; // ID de la pregunta
+    int calidad;
+    int dia;
+  };
+
+private:
+  // Estado SM-2 de un par estudiante×pregunta
+  struct EstadoRepaso {
+    std::uint32_t pregunta;    // Índice compacto de la pregunta
+    std::int32_t vencimiento;  // Día en que vuelve a tocar
+    std::uint16_t intervalo;   // Días entre repasos
+    std::uint16_t generacion;  // Cambia cada vez que se encola
+    std::uint8_t facilidad;    // Factor de facilidad: 1.30 + valor / 100
+    std::uint8_t repeticiones; // Repasos correctos seguidos
+  };
+
+  // Entrada de cola; queda obsoleta cuando el estado se vuelve a encolar
+  // (otra generación) o la pregunta cambia de nivel (otra cola)
+  struct EntradaCola {
+    std::int32_t vencimiento;
+    std::uint32_t pregunta;
+    std::uint16_t generacion;
+    bool operator>(const EntradaCola &otra) const {
+      return vencimiento > otra.vencimiento;
+    }
+  };
+
+  struct Estudiante {
+    std::vector<EstadoRepaso> estados; // Ordenados por índice de pregunta
+    std::array<std::vector<EntradaCola>, CREAR + 1> colas; // Heaps por nivel
+  };
+
+  std::unordered_map<int, std::uint32_t> indicePorId; // ID -> índice
+  std::vector<int> idPorIndice;
+  std::vector<std::uint8_t> nivelPorIndice;
+  std::unordered_map<int, Estudiante> estudiantes;
+
+  static void encolar(std::vector<EntradaCola> &cola, EntradaCola entrada) {
+    cola.push_back(entrada);
+    std::ranges::push_heap(cola, std::greater<>());
+  }
+
+  // Encola el estado en la cola del nivel actual de su pregunta con una
+  // generación nueva; las entradas anteriores del estado quedan obsoletas
+  void programar(Estudiante &estudiante, EstadoRepaso &estado) {
+    estado.generacion++;
+    encolar(estudiante.colas[nivelPorIndice[estado.pregunta]],
+            {estado.vencimiento, estado.pregunta, estado.generacion});
+  }
+
+  // Busca el estado de una pregunta (nullptr si no existe)
+  static EstadoRepaso *buscarEstado(Estudiante &estudiante,
+                                    std::uint32_t pregunta) {
+    auto it = std::ranges::lower_bound(estudiante.estados, pregunta, {},
+                                       &EstadoRepaso::pregunta);
+    return it != estudiante.estados.end() && it->pregunta == pregunta
+               ? &*it
+               : nullptr;
+  }
+
+  // Busca el estado de una pregunta; lo crea (vencido en 'dia') si no existe
+  EstadoRepaso &obtenerEstado(Estudiante &estudiante, std::uint32_t pregunta,
+                              int dia) {
+    auto it = std::ranges::lower_bound(estudiante.estados, pregunta, {},
+                                       &EstadoRepaso::pregunta);
+    if (it == estudiante.estados.end() || it->pregunta != pregunta) {
+      it = estudiante.estados.insert(it, {pregunta, dia, 0, 0, 120, 0});
+      programar(estudiante, *it);
+    }
+    return *it;
+  }
+
+  // Indica si una entrada de la cola del nivel dado sigue reflejando el
+  // estado actual
+  bool vigente(const Estudiante &estudiante, const EntradaCola &e,
+               int nivel) const {
+    if (nivelPorIndice[e.pregunta] != nivel) {
+      return false; // La pregunta cambió de nivel
+    }
+    auto it = std::ranges::lower_bound(estudiante.estados, e.pregunta, {},
+                                       &EstadoRepaso::pregunta);
+    return it != estudiante.estados.end() && it->pregunta == e.pregunta &&
+           it->generacion == e.generacion;
+  }
+
+  // Elimina las entradas obsoletas de las colas que acumulan demasiadas
+  void compactarColas(Estudiante &estudiante) const {
+    for (int nivel = RECORDAR; nivel <= CREAR; ++nivel) {
+      auto &cola = estudiante.colas[nivel];
+      if (cola.size() > 2 * estudiante.estados.size() + 16) {
+        std::erase_if(cola, [&](const EntradaCola &entrada) {
+          return !vigente(estudiante, entrada, nivel);
+        });
+        std::ranges::make_heap(cola, std::greater<>());
+      }
+    }
+  }
+
+  // Aplica el algoritmo SM-2 a un estado. Un fallo (calidad < 3) reinicia
+  // las repeticiones sin cambiar el factor de facilidad
+  static void aplicarSM2(EstadoRepaso &estado, int calidad, int dia) {
+    calidad = std::clamp(calidad, 0, 5);
+    double facilidad = 1.3 + estado.facilidad / 100.0;
+    if (calidad < 3) {
+      estado.repeticiones = 0;
+      estado.intervalo = 1;
+      estado.vencimiento = dia + estado.intervalo;
+      return;
+    }
+    if (estado.repeticiones < 255) {
+      estado.repeticiones++;
+    }
+    double intervalo = estado.intervalo * facilidad;
+    if (estado.repeticiones == 1) {
+      intervalo = 1.0;
+    } else if (estado.repeticiones == 2) {
+      intervalo = 6.0;
+    }
+    estado.intervalo = static_cast<std::uint16_t>(
+        std::min(65535.0, std::round(intervalo)));
+    int fallo = 5 - calidad;
+    facilidad += 0.1 - fallo * (0.08 + fallo * 0.02);
+    estado.facilidad = static_cast<std::uint8_t>(
+        std::lround(std::clamp(facilidad, 1.3, 3.85) * 100.0) - 130);
+    estado.vencimiento = dia + estado.intervalo;
+  }
+
+public:
+  // Método para registrar (o actualizar) las preguntas del banco
+  void sincronizarPreguntas(const GestorPreguntas &gestor) {
+    for (const Pregunta &p : gestor.vistaPreguntas()) {
+      registrarPregunta(p.getId(), p.getNivelBloom());
+    }
+  }
+
+  // Método para registrar una pregunta practicable. Si la pregunta cambia
+  // de nivel, sus estados se mueven a la cola del nivel nuevo
+  void registrarPregunta(int id, int nivelBloom) {
+    if (nivelBloom < RECORDAR || nivelBloom > CREAR) {
+      return;
+    }
+    auto [it, nueva] = indicePorId.try_emplace(
+        id, static_cast<std::uint32_t>(idPorIndice.size()));
+    if (nueva) {
+      idPorIndice.push_back(id);
+      nivelPorIndice.push_back(static_cast<std::uint8_t>(nivelBloom));
+      return;
+    }
+    std::uint32_t indice = it->second;
+    if (nivelPorIndice[indice] == nivelBloom) {
+      return;
+    }
+    nivelPorIndice[indice] = static_cast<std::uint8_t>(nivelBloom);
+    for (auto &[idEstudiante, estudiante] : estudiantes) {
+      if (EstadoRepaso *estado = buscarEstado(estudiante, indice)) {
+        programar(estudiante, *estado);
+        compactarColas(estudiante);
+      }
+    }
+  }
+
+  // Método para agregar una pregunta a la práctica de un estudiante
+  bool introducir(int estudiante, int idPregunta, int dia) {
+    auto it = indicePorId.find(idPregunta);
+    if (it == indicePorId.end()) {
+      return false;
+    }
+    obtenerEstado(estudiantes[estudiante], it->second, dia);
+    return true;
+  }
+
+  // Método para aplicar un lote de repasos. Se agrupan por estudiante para
+  // buscar cada estudiante una sola vez; dentro de un estudiante se aplican
+  // en orden de día
+  void aplicarRevisiones(std::vector<Revision> lote) {
+    std::ranges::stable_sort(lote, [](const Revision &a, const Revision &b) {
+      return a.estudiante != b.estudiante ? a.estudiante < b.estudiante
+                                          : a.dia < b.dia;
+    });
+
+    Estudiante *estudiante = nullptr;
+    int idEstudiante = 0;
+    for (const Revision &r : lote) {
+      auto itPregunta = indicePorId.find(r.pregunta);
+      if (itPregunta == indicePorId.end()) {
+        continue; // Pregunta desconocida
+      }
+      if (!estudiante || idEstudiante != r.estudiante) {
+        if (estudiante) {
+          compactarColas(*estudiante);
+        }
+        estudiante = &estudiantes[r.estudiante];
+        idEstudiante = r.estudiante;
+      }
+      std::uint32_t indice = itPregunta->second;
+      EstadoRepaso &estado = obtenerEstado(*estudiante, indice, r.dia);
+      aplicarSM2(estado, r.calidad, r.dia);
+      programar(*estudiante, estado);
+    }
+
+    if (estudiante) {
+      compactarColas(*estudiante);
+    }
+  }
+
+  // Método para obtener hasta 'cantidad' preguntas vencidas en 'dia' para un
+  // estudiante. Los niveles se intercalan en proporción a 'pesos' (índice =
+  // nivel de Bloom); dentro de un nivel salen primero las más atrasadas
+  std::vector<int>
+  siguientesVencidas(int idEstudiante, int dia, std::size_t cantidad,
+                     const std::array<double, CREAR + 1> &pesos = {
+                         0, 1, 1, 1, 1, 1, 1}) {
+    std::vector<int> resultado;
+    auto it = estudiantes.find(idEstudiante);
+    if (it == estudiantes.end()) {
+      return resultado;
+    }
+    Estudiante &estudiante = it->second;
+    std::array<std::vector<EntradaCola>, CREAR + 1> tomadas;
+    std::unordered_set<std::uint32_t> entregadas; // Sin repetir preguntas
+
+    while (resultado.size() < cantidad) {
+      int mejorNivel = 0;
+      double mejorPrioridad = 0.0;
+      for (int nivel = RECORDAR; nivel <= CREAR; ++nivel) {
+        auto &cola = estudiante.colas[nivel];
+        // Descarta las entradas obsoletas del tope
+        while (!cola.empty() && (!vigente(estudiante, cola.front(), nivel) ||
+                                 entregadas.count(cola.front().pregunta))) {
+          std::ranges::pop_heap(cola, std::greater<>());
+          cola.pop_back();
+        }
+        if (cola.empty() || cola.front().vencimiento > dia) {
+          continue;
+        }
+        double prioridad = pesos[nivel] / (1.0 + tomadas[nivel].size());
+        if (prioridad > mejorPrioridad) {
+          mejorPrioridad = prioridad;
+          mejorNivel = nivel;
+        }
+      }
+      if (mejorNivel == 0) {
+        break; // No quedan preguntas vencidas
+      }
+      auto &cola = estudiante.colas[mejorNivel];
+      std::ranges::pop_heap(cola, std::greater<>());
+      tomadas[mejorNivel].push_back(cola.back());
+      cola.pop_back();
+      entregadas.insert(tomadas[mejorNivel].back().pregunta);
+      resultado.push_back(idPorIndice[tomadas[mejorNivel].back().pregunta]);
+    }
+
+    // Consultar no modifica el plan: las entradas vuelven a sus colas
+    for (int nivel = RECORDAR; nivel <= CREAR; ++nivel) {
+      for (const EntradaCola &entrada : tomadas[nivel]) {
+        encolar(estudiante.colas[nivel], entrada);
+      }
+    }
+    return resultado;
+  }
+
+  // Getters
+  std::size_t getCantidadEstudiantes() const { return estudiantes.size(); }
+  std::size_t getCantidadEstados() const {
+    std::size_t total = 0;
+    for (const auto &[id, e] : estudiantes) {
+      total += e.estados.size();
+    }
+    return total;
+  }
+};
+
+// Agrupador Temático - Representa cada pregunta (texto y opciones) como un
+// vector TF-IDF disperso y las agrupa por tema con k-means por mini-lotes.
+// Los centroides se guardan transpuestos (término × grupo), de modo que la
+// similitud de un vector disperso con todos los centroides recorre memoria
+// contigua por cada término y el compilador puede vectorizar el bucle
+// interno. Las preguntas nuevas se asignan y ajustan los centroides sin
+// volver a agrupar todo el banco.
+class AgrupadorTematico {
+private:
+  using VectorDisperso = std::vector<std::pair<std::uint32_t, float>>;
+
+  std::size_t cantidadGrupos = 0;
+  std::unordered_map<std::string, std::uint32_t> vocabulario;
+  std::vector<std::uint32_t> frecuenciaDocumentos; // Por término
+  std::size_t cantidadDocumentos = 0;
+
+  // Centroide j = escala[j] * pesos[t * cantidadGrupos + j]. La escala evita
+  // recorrer todo el vocabulario al encoger un centroide en cada ajuste
+  std::vector<float> pesos;
+  std::vector<double> escala;
+  std::vector<double> normaCuadrada;
+  std::vector<std::size_t> conteo; // Puntos asignados a cada grupo
+
+  // Divide un texto en términos: minúsculas ASCII, los bytes UTF-8 (letras
+  // con tilde, ñ) forman parte de la palabra y se ignoran términos de una
+  // sola letra
+  static std::vector<std::string> tokenizar(const std::string &texto) {
+    std::vector<std::string> terminos;
+    std::string actual;
+    for (char c : texto) {
+      unsigned char u = static_cast<unsigned char>(c);
+      if (std::isalnum(u) || u >= 0x80) {
+        actual += static_cast<char>(std::tolower(u));
+      } else {
+        if (actual.size() > 1) {
+          terminos.push_back(std::move(actual));
+        }
+        actual.clear();
       }
     }
-
-    // Verificar si la pregunta existe en el año anterior
-    if (anio > 1 && preguntasPorAnio.count(anio - 1) > 0) {
-      if (preguntasPorAnio[anio - 1].count(texto) > 0) {
-        return true;
-      }
+    if (actual.size() > 1) {
+      terminos.push_back(std::move(actual));
     }
+    return terminos;
+  }
 
-    // Verificar similitud con otras preguntas (implementación simplificada)
-    if (textoAPreguntaId.count(texto) > 0) {
-      return true;
+  // Incorpora los términos de un documento al vocabulario y sus frecuencias
+  void registrarDocumento(const std::vector<std::string> &terminos) {
+    std::unordered_set<std::uint32_t> vistos;
+    for (const auto &termino : terminos) {
+      auto [it, nuevo] = vocabulario.try_emplace(
+          termino, static_cast<std::uint32_t>(frecuenciaDocumentos.size()));
+      if (nuevo) {
+        frecuenciaDocumentos.push_back(0);
+        pesos.resize(pesos.size() + cantidadGrupos, 0.0f);
+      }
+      if (vistos.insert(it->second).second) {
+        frecuenciaDocumentos[it->second]++;
+      }
     }
-
-    return false;
+    cantidadDocumentos++;
   }
 
-public:
-  // Método para agregar una pregunta con validación
-  int agregarPregunta(std::unique_ptr<Pregunta> pregunta) {
-    std::string texto = pregunta->getTexto();
-    int anio = pregunta->getAnio();
-
-    // Validar si la pregunta es similar a otra existente
-    if (esPreguntaSimilar(texto, anio)) {
-      return -1; // Indica que la pregunta es similar a otra existente
+  // Vector TF-IDF normalizado (norma 1) de un documento ya registrado
+  VectorDisperso vectorizar(const std::vector<std::string> &terminos) const {
+    std::map<std::uint32_t, float> frecuencias;
+    for (const auto &termino : terminos) {
+      auto it = vocabulario.find(termino);
+      if (it != vocabulario.end()) {
+        frecuencias[it->second] += 1.0f;
+      }
     }
-
-    // Asignar un nuevo ID y agregar la pregunta
-    int id = siguienteId++;
-    pregunta->setAnio(anio);
-
-    // Registrar la pregunta en los mapas de validación
-    if (anio > 0) {
-      preguntasPorAnio[anio].insert(texto);
+    VectorDisperso vector;
+    double norma = 0.0;
+    for (const auto &[t, tf] : frecuencias) {
+      double idf = std::log((1.0 + cantidadDocumentos) /
+                            (1.0 + frecuenciaDocumentos[t])) +
+                   1.0;
+      float peso = static_cast<float>(tf * idf);
+      vector.emplace_back(t, peso);
+      norma += static_cast<double>(peso) * peso;
     }
-    textoAPreguntaId[texto] = id;
-
-    preguntas.push_back(std::move(pregunta));
-    return id;
+    if (norma > 0.0) {
+      float inversa = static_cast<float>(1.0 / std::sqrt(norma));
+      for (auto &[t, peso] : vector) {
+        peso *= inversa;
+      }
+    }
+    return vector;
   }
 
-  // Método para actualizar una pregunta existente
-  bool actualizarPregunta(int id,
-                          std::unique_ptr<Pregunta> preguntaActualizada) {
-    auto it = std::find_if(
-        preguntas.begin(), preguntas.end(),
-        [id](const std::unique_ptr<Pregunta> &p) { return p->getId() == id; });
-
-    if (it != preguntas.end()) {
-      // Eliminar la pregunta anterior de los mapas de validación
-      std::string textoAnterior = (*it)->getTexto();
-      int anioAnterior = (*it)->getAnio();
-
-      if (anioAnterior > 0) {
-        preguntasPorAnio[anioAnterior].erase(textoAnterior);
+  // Producto escalar de un vector con todos los centroides (sin escala)
+  void productos(const VectorDisperso &x, std::vector<float> &acumulado) const {
+    std::fill(acumulado.begin(), acumulado.end(), 0.0f);
+    const std::size_t k = cantidadGrupos;
+    for (const auto &[t, valor] : x) {
+      const float *fila = &pesos[static_cast<std::size_t>(t) * k];
+      float *destino = acumulado.data();
+      for (std::size_t j = 0; j < k; ++j) {
+        destino[j] += valor * fila[j];
       }
-      textoAPreguntaId.erase(textoAnterior);
-
-      // Validar si la nueva versión es similar a otra existente (que no sea la
-      // misma)
-      std::string nuevoTexto = preguntaActualizada->getTexto();
-      int nuevoAnio = preguntaActualizada->getAnio();
+    }
+  }
 
-      if (nuevoTexto != textoAnterior &&
-          esPreguntaSimilar(nuevoTexto, nuevoAnio)) {
-        // Volver a registrar la pregunta anterior para mantener consistencia
-        if (anioAnterior > 0) {
-          preguntasPorAnio[anioAnterior].insert(textoAnterior);
-        }
-        textoAPreguntaId[textoAnterior] = id;
-        return false; // La actualización falló por similitud
+  // Grupo más cercano: minimiza |x - c|^2 = 1 - 2 x·c + |c|^2
+  int masCercano(const VectorDisperso &x, std::vector<float> &acumulado) const {
+    productos(x, acumulado);
+    int mejor = 0;
+    double mejorPuntaje = -std::numeric_limits<double>::infinity();
+    for (std::size_t j = 0; j < cantidadGrupos; ++j) {
+      double puntaje = 2.0 * escala[j] * acumulado[j] - normaCuadrada[j];
+      if (puntaje > mejorPuntaje) {
+        mejorPuntaje = puntaje;
+        mejor = static_cast<int>(j);
       }
+    }
+    return mejor;
+  }
 
-      // Registrar la nueva versión en los mapas de validación
-      if (nuevoAnio > 0) {
-        preguntasPorAnio[nuevoAnio].insert(nuevoTexto);
+  // Calcula el grupo más cercano de cada vector, en paralelo si son
+  // suficientes para compensar el reparto
+  void asignarEnParalelo(const std::vector<const VectorDisperso *> &vectores,
+                         std::vector<int> &asignacion) const {
+    asignacion.resize(vectores.size());
+    auto asignarRango = [&](std::size_t, std::size_t inicio, std::size_t fin) {
+      std::vector<float> acumulado(cantidadGrupos);
+      for (std::size_t i = inicio; i < fin; ++i) {
+        asignacion[i] = masCercano(*vectores[i], acumulado);
       }
-      textoAPreguntaId[nuevoTexto] = id;
-
-      // Actualizar la pregunta
-      *it = std::move(preguntaActualizada);
-      return true;
+    };
+    if (vectores.size() < 4096) {
+      asignarRango(0, 0, vectores.size());
+    } else {
+      PoolHilos::global().paraCadaBloque(vectores.size(), 1024, asignarRango);
     }
-    return false;
   }
 
-  // Método para eliminar una pregunta
-  bool eliminarPregunta(int id) {
-    auto it = std::find_if(
-        preguntas.begin(), preguntas.end(),
-        [id](const std::unique_ptr<Pregunta> &p) { return p->getId() == id; });
-
-    if (it != preguntas.end()) {
-      // Eliminar la pregunta de los mapas de validación
-      std::string texto = (*it)->getTexto();
-      int anio = (*it)->getAnio();
-
-      if (anio > 0) {
-        preguntasPorAnio[anio].erase(texto);
+  // Acerca el centroide j al vector x con tasa 1 / (puntos asignados)
+  void ajustar(int j, const VectorDisperso &x) {
+    const std::size_t k = cantidadGrupos;
+    double eta = 1.0 / static_cast<double>(++conteo[j]);
+    double producto = 0.0, normaX = 0.0;
+    for (const auto &[t, valor] : x) {
+      producto += valor * pesos[static_cast<std::size_t>(t) * k + j];
+      normaX += static_cast<double>(valor) * valor;
+    }
+    producto *= escala[j];
+
+    // c' = (1 - eta) c + eta x
+    normaCuadrada[j] = (1.0 - eta) * (1.0 - eta) * normaCuadrada[j] +
+                       2.0 * (1.0 - eta) * eta * producto + eta * eta * normaX;
+    if (eta >= 1.0) {
+      for (std::size_t t = 0; t < frecuenciaDocumentos.size(); ++t) {
+        pesos[t * k + j] = 0.0f;
       }
-      textoAPreguntaId.erase(texto);
+      escala[j] = 1.0;
+    } else {
+      escala[j] *= 1.0 - eta;
+    }
+    for (const auto &[t, valor] : x) {
+      pesos[static_cast<std::size_t>(t) * k + j] +=
+          static_cast<float>(eta * valor / escala[j]);
+    }
 
-      // Eliminar la pregunta
-      preguntas.erase(it);
-      return true;
+    // Reaplica la escala antes de que pierda precisión
+    if (escala[j] < 1e-6) {
+      for (std::size_t t = 0; t < frecuenciaDocumentos.size(); ++t) {
+        pesos[t * k + j] *= static_cast<float>(escala[j]);
+      }
+      escala[j] = 1.0;
     }
-    return false;
   }
 
-  // Método para obtener una pregunta por su ID
-  Pregunta *getPregunta(int id) {
-    auto it = std::find_if(
-        preguntas.begin(), preguntas.end(),
-        [id](const std::unique_ptr<Pregunta> &p) { return p->getId() == id; });
+public:
+  // Método para agrupar todo el banco en 'grupos' temas y asignar a cada
+  // pregunta su grupo temático. La asignación pasa por el gestor como una
+  // sola operación versionada, que se puede deshacer
+  void entrenar(GestorPreguntas &gestor, std::size_t grupos,
+                std::size_t tamLote = 256, int iteraciones = 100,
+                unsigned semilla = 12345) {
+    std::vector<const Pregunta *> preguntas;
+    for (const Pregunta &p : gestor.vistaPreguntas()) {
+      preguntas.push_back(&p);
+    }
 
-    if (it != preguntas.end()) {
-      return it->get();
+    vocabulario.clear();
+    frecuenciaDocumentos.clear();
+    cantidadDocumentos = 0;
+    cantidadGrupos = std::min(grupos, preguntas.size());
+    pesos.clear();
+
+    std::vector<std::vector<std::string>> terminos;
+    terminos.reserve(preguntas.size());
+    for (const Pregunta *p : preguntas) {
+      terminos.push_back(tokenizar(p->getTextoCompleto()));
+      registrarDocumento(terminos.back());
+    }
+    std::vector<VectorDisperso> vectores(preguntas.size());
+    for (std::size_t i = 0; i < preguntas.size(); ++i) {
+      vectores[i] = vectorizar(terminos[i]);
     }
-    return nullptr;
-  }
 
-  // Método para buscar preguntas por nivel de Bloom
-  std::vector<Pregunta *> buscarPorNivelBloom(int nivel) {
-    std::vector<Pregunta *> resultado;
-    for (const auto &p : preguntas) {
-      if (p->getNivelBloom() == nivel) {
-        resultado.push_back(p.get());
-      }
+    // Centroides iniciales: documentos distintos elegidos al azar
+    std::mt19937 generador(semilla);
+    pesos.assign(frecuenciaDocumentos.size() * cantidadGrupos, 0.0f);
+    escala.assign(cantidadGrupos, 1.0);
+    normaCuadrada.assign(cantidadGrupos, 0.0);
+    conteo.assign(cantidadGrupos, 0);
+    std::vector<std::size_t> orden(preguntas.size());
+    std::iota(orden.begin(), orden.end(), 0);
+    std::shuffle(orden.begin(), orden.end(), generador);
+    for (std::size_t j = 0; j < cantidadGrupos; ++j) {
+      ajustar(static_cast<int>(j), vectores[orden[j]]);
+    }
+    if (cantidadGrupos == 0) {
+      return;
     }
-    return resultado;
-  }
 
-  // Método para buscar preguntas por año
-  std::vector<Pregunta *> buscarPorAnio(int anio) {
-    std::vector<Pregunta *> resultado;
-    for (const auto &p : preguntas) {
-      if (p->getAnio() == anio) {
-        resultado.push_back(p.get());
+    // Mini-lotes: asignación en paralelo, ajuste secuencial
+    std::uniform_int_distribution<std::size_t> azar(0, preguntas.size() - 1);
+    std::vector<const VectorDisperso *> lote(
+        std::min(tamLote, preguntas.size()));
+    std::vector<int> asignacion;
+    for (int iteracion = 0; iteracion < iteraciones; ++iteracion) {
+      for (auto &x : lote) {
+        x = &vectores[azar(generador)];
+      }
+      asignarEnParalelo(lote, asignacion);
+      for (std::size_t i = 0; i < lote.size(); ++i) {
+        ajustar(asignacion[i], *lote[i]);
       }
     }
-    return resultado;
-  }
 
-  // Método para calcular el tiempo total estimado
-  int calcularTiempoTotal() {
-    int tiempoTotal = 0;
-    for (const auto &p : preguntas) {
-      tiempoTotal += p->getTiempoEstimado();
+    // Asignación final de todo el banco
+    std::vector<const VectorDisperso *> todos;
+    for (const auto &x : vectores) {
+      todos.push_back(&x);
     }
-    return tiempoTotal;
+    asignarEnParalelo(todos, asignacion);
+    std::vector<std::pair<int, int>> asignaciones;
+    asignaciones.reserve(preguntas.size());
+    for (std::size_t i = 0; i < preguntas.size(); ++i) {
+      asignaciones.emplace_back(preguntas[i]->getId(), asignacion[i]);
+    }
+    gestor.asignarGruposTematicos(asignaciones);
   }
 
-  // Método para obtener todas las preguntas
-  std::vector<Pregunta *> getTodasLasPreguntas() {
-    std::vector<Pregunta *> resultado;
-    for (const auto &p : preguntas) {
-      resultado.push_back(p.get());
+  // Método para asignar el grupo de una pregunta nueva del banco y ajustar
+  // con ella su centroide, sin reagrupar el banco. Devuelve el grupo asignado
+  // (-1 si la pregunta no existe o el agrupador aún no fue entrenado)
+  int agregar(GestorPreguntas &gestor, int id) {
+    const Pregunta *pregunta = gestor.getPregunta(id);
+    if (cantidadGrupos == 0 || !pregunta) {
+      return -1;
     }
-    return resultado;
+    auto terminos = tokenizar(pregunta->getTextoCompleto());
+    registrarDocumento(terminos);
+    VectorDisperso x = vectorizar(terminos);
+    std::vector<float> acumulado(cantidadGrupos);
+    int grupo = masCercano(x, acumulado);
+    ajustar(grupo, x);
+    gestor.asignarGruposTematicos({{id, grupo}});
+    return grupo;
   }
+
+  // Getters
+  std::size_t getCantidadGrupos() const { return cantidadGrupos; }
+  std::size_t getTamVocabulario() const { return frecuenciaDocumentos.size(); }
 };
 
 // Interfaz de Usuario - Maneja la interacción con el usuario
 class InterfazUsuario {
 private:
   GestorPreguntas gestor; // Gestor de preguntas para operaciones CRUD
+  RegistroTiemposRespuesta tiempos; // Tiempos observados de los estudiantes
+  AgrupadorTematico agrupador; // Temas del banco (tras la primera agrupación)
+  static constexpr std::size_t TAM_PAGINA = 10; // Preguntas por página
 
   // Método para limpiar la pantalla
   void limpiarPantalla() {
@@ -425,6 +7013,33 @@ private:
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
   }
 
+  // Método para preguntar si se sigue listando tras una página completa.
+  // Devuelve false si el usuario escribe 'q'
+  bool continuarListado() {
+    std::cout << "\nEnter para ver más, 'q' para terminar: ";
+    std::string entrada;
+    std::getline(std::cin, entrada);
+    return entrada.empty() || (entrada[0] != 'q' && entrada[0] != 'Q');
+  }
+
+  // Método para mostrar un rango perezoso de preguntas, pausando después de
+  // cada página. Los resultados no se copian: se leen al iterar la vista
+  template <typename RangoPreguntas>
+  void mostrarPorPaginas(RangoPreguntas &&preguntas) {
+    std::size_t enPagina = 0;
+    for (const Pregunta &p : preguntas) {
+      if (enPagina == TAM_PAGINA) {
+        if (!continuarListado()) {
+          return;
+        }
+        enPagina = 0;
+      }
+      p.mostrar();
+      std::cout << "------------------------\n";
+      ++enPagina;
+    }
+  }
+
   // Método para obtener entrada numérica validada
   int obtenerEntradaInt(const std::string &mensaje, int min, int max) {
     int entrada;
@@ -452,6 +7067,20 @@ private:
     return entrada;
   }
 
+  // Método para listar ID y resumen de cada pregunta (recorre la vista
+  // perezosa del gestor sin copiar la colección)
+  void listarPreguntasDisponibles() {
+    std::cout << "Preguntas disponibles:\n";
+    for (const Pregunta &p : gestor.vistaPreguntas()) {
+      std::cout << "ID: " << p.getId() << " - " << p.getTexto().substr(0, 50)
+                << (p.getTexto().length() > 50 ? "..." : "") << " ("
+                << p.getTipo() << ")"
+                << (p.getAnio() > 0 ? " - Año: " + std::to_string(p.getAnio())
+                                     : "")
+                << "\n";
+    }
+  }
+
 public:
   // Método para mostrar el menú principal
   void mostrarMenu() {
@@ -465,6 +7094,15 @@ public:
     std::cout << "5. Buscar preguntas por año\n";
     std::cout << "6. Mostrar todas las preguntas\n";
     std::cout << "7. Mostrar tiempo estimado de finalización del test\n";
+    std::cout << "8. Deshacer el último cambio\n";
+    std::cout << "9. Rehacer el último cambio deshecho\n";
+    std::cout << "10. Buscar preguntas por nivel de Bloom y año\n";
+    std::cout << "11. Guardar el banco en un archivo\n";
+    std::cout << "12. Cargar preguntas desde un archivo\n";
+    std::cout << "13. Exportar un examen a LaTeX o HTML\n";
+    std::cout << "14. Agrupar preguntas por tema\n";
+    std::cout << "15. Cargar respuestas de estudiantes (tiempos e IRT)\n";
+    std::cout << "16. Rendir un test adaptativo\n";
     std::cout << "0. Salir\n";
     std::cout << "Ingrese su opción: ";
   }
@@ -474,7 +7112,7 @@ public:
     bool ejecutando = true;
     while (ejecutando) {
       mostrarMenu();
-      int opcion = obtenerEntradaInt("", 0, 7);
+      int opcion = obtenerEntradaInt("", 0, 16);
 
       switch (opcion) {
       case 0:
@@ -501,6 +7139,33 @@ public:
       case 7:
         mostrarTiempoTotal();
         break;
+      case 8:
+        deshacerCambio();
+        break;
+      case 9:
+        rehacerCambio();
+        break;
+      case 10:
+        buscarPreguntasCombinada();
+        break;
+      case 11:
+        guardarBanco();
+        break;
+      case 12:
+        cargarBanco();
+        break;
+      case 13:
+        exportarExamen();
+        break;
+      case 14:
+        agruparPorTema();
+        break;
+      case 15:
+        cargarRespuestas();
+        break;
+      case 16:
+        rendirTestAdaptativo();
+        break;
       }
     }
   }
@@ -607,6 +7272,12 @@ public:
     int id = gestor.agregarPregunta(std::move(pregunta));
     if (id > 0) {
       std::cout << "Pregunta agregada exitosamente con ID: " << id << "\n";
+      // Si el banco ya se agrupó, la pregunta nueva recibe su tema sin
+      // reagrupar todo el banco
+      int grupo = agrupador.agregar(gestor, id);
+      if (grupo >= 0) {
+        std::cout << "Tema asignado: " << (grupo + 1) << "\n";
+      }
     } else {
       std::cout << "Error: La pregunta es similar a otra existente en el mismo "
                    "año o año anterior.\n";
@@ -620,35 +7291,30 @@ public:
     limpiarPantalla();
     std::cout << "===== Actualizar una Pregunta =====\n";
 
-    auto todasLasPreguntas = gestor.getTodasLasPreguntas();
-    if (todasLasPreguntas.empty()) {
+    if (gestor.estaVacio()) {
       std::cout << "No hay preguntas disponibles para actualizar.\n";
       esperarEnter();
       return;
     }
 
-    std::cout << "Preguntas disponibles:\n";
-    for (const auto &p : todasLasPreguntas) {
-      std::cout << "ID: " << p->getId() << " - " << p->getTexto().substr(0, 50)
-                << (p->getTexto().length() > 50 ? "..." : "") << " ("
-                << p->getTipo() << ")"
-                << (p->getAnio() > 0 ? " - Año: " + std::to_string(p->getAnio())
-                                     : "")
-                << "\n";
-    }
+    listarPreguntasDisponibles();
 
     int id = obtenerEntradaInt("Ingrese el ID de la pregunta a actualizar: ", 0,
                                std::numeric_limits<int>::max());
-    Pregunta *pregunta = gestor.getPregunta(id);
+    const Pregunta *actual = gestor.getPregunta(id);
 
-    if (!pregunta) {
+    if (!actual) {
       std::cout << "Pregunta no encontrada.\n";
       esperarEnter();
       return;
     }
 
     std::cout << "Detalles actuales de la pregunta:\n";
-    pregunta->mostrar();
+    actual->mostrar();
+
+    // Se edita una copia: la pregunta del banco solo cambia si el gestor
+    // acepta la actualización completa
+    std::unique_ptr<Pregunta> pregunta = actual->clonar();
 
     std::string texto =
         obtenerEntradaString("Ingrese el nuevo texto de la pregunta (deje "
@@ -697,7 +7363,7 @@ public:
     // Actualizaciones específicas según el tipo
     if (pregunta->getTipo() == "Opción Múltiple") {
       PreguntaOpcionMultiple *pom =
-          dynamic_cast<PreguntaOpcionMultiple *>(pregunta);
+          dynamic_cast<PreguntaOpcionMultiple *>(pregunta.get());
       if (pom) {
         int actualizarOpciones = obtenerEntradaInt(
             "¿Actualizar opciones? (1 para Sí, 0 para No): ", 0, 1);
@@ -728,7 +7394,7 @@ public:
       }
     } else if (pregunta->getTipo() == "Verdadero/Falso") {
       PreguntaVerdaderoFalso *pvf =
-          dynamic_cast<PreguntaVerdaderoFalso *>(pregunta);
+          dynamic_cast<PreguntaVerdaderoFalso *>(pregunta.get());
       if (pvf) {
         int actualizarRespuesta = obtenerEntradaInt(
             "¿Actualizar respuesta correcta? (1 para Sí, 0 para No): ", 0, 1);
@@ -741,7 +7407,7 @@ public:
       }
     } else if (pregunta->getTipo() == "Emparejamiento") {
       PreguntaEmparejamiento *pe =
-          dynamic_cast<PreguntaEmparejamiento *>(pregunta);
+          dynamic_cast<PreguntaEmparejamiento *>(pregunta.get());
       if (pe) {
         int actualizarElementos = obtenerEntradaInt(
             "¿Actualizar elementos de emparejamiento? (1 para Sí, 0 para No): ",
@@ -800,30 +7466,7 @@ public:
       }
     }
 
-    // Crear una copia de la pregunta actualizada para pasarla al gestor
-    std::unique_ptr<Pregunta> preguntaActualizada;
-    if (pregunta->getTipo() == "Opción Múltiple") {
-      PreguntaOpcionMultiple *pom =
-          dynamic_cast<PreguntaOpcionMultiple *>(pregunta);
-      preguntaActualizada = std::make_unique<PreguntaOpcionMultiple>(
-          id, pom->getTexto(), pom->getNivelBloom(), pom->getTiempoEstimado(),
-          pom->getOpciones(), pom->getOpcionCorrecta(), pom->getAnio());
-    } else if (pregunta->getTipo() == "Verdadero/Falso") {
-      PreguntaVerdaderoFalso *pvf =
-          dynamic_cast<PreguntaVerdaderoFalso *>(pregunta);
-      preguntaActualizada = std::make_unique<PreguntaVerdaderoFalso>(
-          id, pvf->getTexto(), pvf->getNivelBloom(), pvf->getTiempoEstimado(),
-          pvf->getRespuestaCorrecta(), pvf->getAnio());
-    } else if (pregunta->getTipo() == "Emparejamiento") {
-      PreguntaEmparejamiento *pe =
-          dynamic_cast<PreguntaEmparejamiento *>(pregunta);
-      preguntaActualizada = std::make_unique<PreguntaEmparejamiento>(
-          id, pe->getTexto(), pe->getNivelBloom(), pe->getTiempoEstimado(),
-          pe->getElementosIzquierda(), pe->getElementosDerecha(),
-          pe->getEmparejamientosCorrectos(), pe->getAnio());
-    }
-
-    if (gestor.actualizarPregunta(id, std::move(preguntaActualizada))) {
+    if (gestor.actualizarPregunta(id, std::move(pregunta))) {
       std::cout << "Pregunta actualizada exitosamente.\n";
     } else {
       std::cout << "Error: No se pudo actualizar la pregunta. Puede ser "
@@ -838,22 +7481,13 @@ public:
     limpiarPantalla();
     std::cout << "===== Eliminar una Pregunta =====\n";
 
-    auto todasLasPreguntas = gestor.getTodasLasPreguntas();
-    if (todasLasPreguntas.empty()) {
+    if (gestor.estaVacio()) {
       std::cout << "No hay preguntas disponibles para eliminar.\n";
       esperarEnter();
       return;
     }
 
-    std::cout << "Preguntas disponibles:\n";
-    for (const auto &p : todasLasPreguntas) {
-      std::cout << "ID: " << p->getId() << " - " << p->getTexto().substr(0, 50)
-                << (p->getTexto().length() > 50 ? "..." : "") << " ("
-                << p->getTipo() << ")"
-                << (p->getAnio() > 0 ? " - Año: " + std::to_string(p->getAnio())
-                                     : "")
-                << "\n";
-    }
+    listarPreguntasDisponibles();
 
     int id = obtenerEntradaInt("Ingrese el ID de la pregunta a eliminar: ", 0,
                                std::numeric_limits<int>::max());
@@ -883,20 +7517,17 @@ public:
     int nivelBloom = obtenerEntradaInt(
         "Ingrese el nivel de Bloom para buscar (1-6): ", 1, 6);
 
-    auto preguntas = gestor.buscarPorNivelBloom(nivelBloom);
+    std::size_t cantidad = gestor.contarPorNivelBloom(nivelBloom);
 
-    if (preguntas.empty()) {
+    if (cantidad == 0) {
       std::cout << "No se encontraron preguntas para el nivel de Bloom: "
                 << Pregunta::getNombreNivelBloom(nivelBloom) << "\n";
     } else {
-      std::cout << "Se encontraron " << preguntas.size()
+      std::cout << "Se encontraron " << cantidad
                 << " preguntas para el nivel de Bloom: "
                 << Pregunta::getNombreNivelBloom(nivelBloom) << "\n\n";
 
-      for (const auto &p : preguntas) {
-        p->mostrar();
-        std::cout << "------------------------\n";
-      }
+      mostrarPorPaginas(gestor.vistaPorNivelBloom(nivelBloom));
     }
 
     esperarEnter();
@@ -909,18 +7540,46 @@ public:
 
     int anio = obtenerEntradaInt("Ingrese el año para buscar: ", 0, 2100);
 
-    auto preguntas = gestor.buscarPorAnio(anio);
+    std::size_t cantidad = gestor.contarPorAnio(anio);
 
-    if (preguntas.empty()) {
+    if (cantidad == 0) {
       std::cout << "No se encontraron preguntas para el año: " << anio << "\n";
     } else {
-      std::cout << "Se encontraron " << preguntas.size()
+      std::cout << "Se encontraron " << cantidad
                 << " preguntas para el año: " << anio << "\n\n";
 
-      for (const auto &p : preguntas) {
-        p->mostrar();
-        std::cout << "------------------------\n";
-      }
+      mostrarPorPaginas(gestor.vistaPorAnio(anio));
+    }
+
+    esperarEnter();
+  }
+
+  // Método para buscar preguntas por nivel de Bloom y año a la vez
+  void buscarPreguntasCombinada() {
+    limpiarPantalla();
+    std::cout << "===== Buscar Preguntas por Nivel de Bloom y Año =====\n";
+
+    ConsultaPreguntas consulta;
+    consulta.nivelBloom = obtenerEntradaInt(
+        "Ingrese el nivel de Bloom para buscar (1-6): ", 1, 6);
+    consulta.anio = obtenerEntradaInt("Ingrese el año para buscar: ", 0, 2100);
+
+    auto preguntas = gestor.buscar(consulta);
+
+    if (preguntas.empty()) {
+      std::cout << "No se encontraron preguntas para el nivel de Bloom: "
+                << Pregunta::getNombreNivelBloom(consulta.nivelBloom)
+                << " y el año: " << consulta.anio << "\n";
+    } else {
+      std::cout << "Se encontraron " << preguntas.size()
+                << " preguntas para el nivel de Bloom: "
+                << Pregunta::getNombreNivelBloom(consulta.nivelBloom)
+                << " y el año: " << consulta.anio << "\n\n";
+
+      auto aReferencia = [](const Pregunta *p) -> const Pregunta & {
+        return *p;
+      };
+      mostrarPorPaginas(preguntas | std::views::transform(aReferencia));
     }
 
     esperarEnter();
@@ -931,16 +7590,24 @@ public:
     limpiarPantalla();
     std::cout << "===== Todas las Preguntas =====\n";
 
-    auto preguntas = gestor.getTodasLasPreguntas();
-
-    if (preguntas.empty()) {
+    if (gestor.estaVacio()) {
       std::cout << "No hay preguntas disponibles.\n";
     } else {
-      std::cout << "Total de preguntas: " << preguntas.size() << "\n\n";
-
-      for (const auto &p : preguntas) {
-        p->mostrar();
-        std::cout << "------------------------\n";
+      std::cout << "Total de preguntas: " << gestor.getCantidadPreguntas()
+                << "\n\n";
+
+      // Se pide una página a la vez con un cursor: el gestor ubica cada
+      // página con búsqueda binaria a partir del último ID mostrado
+      CursorPreguntas cursor;
+      while (true) {
+        for (const Pregunta &p : gestor.paginaDesde(cursor, TAM_PAGINA)) {
+          p.mostrar();
+          std::cout << "------------------------\n";
+          cursor.ultimoId = p.getId();
+        }
+        if (gestor.paginaDesde(cursor, 1).empty() || !continuarListado()) {
+          break;
+        }
       }
     }
 
@@ -953,8 +7620,27 @@ public:
     std::cout << "===== Tiempo Estimado de Finalización del Test =====\n";
 
     int tiempoTotal = gestor.calcularTiempoTotal();
+    std::cout << "Tiempo total estimado por los autores: ";
+    mostrarDuracion(tiempoTotal);
+
+    // Con tiempos observados: el tiempo en que termina el 90% de los
+    // estudiantes (las preguntas sin observaciones usan el del autor)
+    if (tiempos.tieneObservaciones()) {
+      double observado =
+          tiempos.estimarDuracionExamen(gestor.vistaPreguntas(), 0.9);
+      std::cout << "Tiempo en que termina el 90% de los estudiantes: ";
+      mostrarDuracion(static_cast<int>(std::ceil(observado)));
+    } else {
+      std::cout << "Cargue respuestas de estudiantes (opción 15) para "
+                   "estimarlo con tiempos observados.\n";
+    }
+
+    esperarEnter();
+  }
 
-    std::cout << "Tiempo total estimado: " << tiempoTotal << " minutos";
+  // Método para mostrar una duración en minutos (y en horas si corresponde)
+  void mostrarDuracion(int tiempoTotal) {
+    std::cout << tiempoTotal << " minutos";
     if (tiempoTotal >= 60) {
       int horas = tiempoTotal / 60;
       int minutos = tiempoTotal % 60;
@@ -965,16 +7651,317 @@ public:
                 << ")";
     }
     std::cout << "\n";
+  }
+
+  // Método para guardar el banco en un archivo
+  void guardarBanco() {
+    limpiarPantalla();
+    std::cout << "===== Guardar el Banco en un Archivo =====\n";
+
+    std::string ruta = obtenerEntradaString("Ingrese la ruta del archivo: ");
+    if (ArchivoBanco::guardar(ruta, gestor)) {
+      std::cout << "Banco guardado exitosamente con "
+                << gestor.getCantidadPreguntas() << " preguntas.\n";
+    } else {
+      std::cout << "Error: No se pudo escribir el archivo.\n";
+    }
+
+    esperarEnter();
+  }
+
+  // Método para cargar preguntas desde un archivo
+  void cargarBanco() {
+    limpiarPantalla();
+    std::cout << "===== Cargar Preguntas desde un Archivo =====\n";
+
+    std::string ruta = obtenerEntradaString("Ingrese la ruta del archivo: ");
+    int cargadas = ArchivoBanco::cargar(ruta, gestor);
+    if (cargadas >= 0) {
+      std::cout << "Se cargaron " << cargadas << " preguntas. Las preguntas "
+                << "con ID ocupado o similares a otras se omitieron.\n";
+    } else {
+      std::cout << "Error: No se pudo leer el archivo.\n";
+    }
+
+    esperarEnter();
+  }
+
+  // Método para exportar un examen con una variante por estudiante y su pauta
+  void exportarExamen() {
+    limpiarPantalla();
+    std::cout << "===== Exportar un Examen a LaTeX o HTML =====\n";
+
+    if (gestor.estaVacio()) {
+      std::cout << "No hay preguntas disponibles.\n";
+      esperarEnter();
+      return;
+    }
+
+    std::istringstream ids(obtenerEntradaString(
+        "Ingrese los IDs de las preguntas separados por espacios: "));
+    std::vector<const Pregunta *> preguntas;
+    int id;
+    while (ids >> id) {
+      if (const Pregunta *p = gestor.getPregunta(id)) {
+        preguntas.push_back(p);
+      } else {
+        std::cout << "No existe la pregunta con ID " << id << ", se omite.\n";
+      }
+    }
+    if (preguntas.empty()) {
+      std::cout << "Error: El examen no tiene preguntas.\n";
+      esperarEnter();
+      return;
+    }
+
+    int formato = obtenerEntradaInt("Formato (1. LaTeX, 2. HTML): ", 1, 2);
+    int variantes = obtenerEntradaInt("Cantidad de variantes: ", 1, 100000);
+    std::string titulo = obtenerEntradaString("Título del examen: ");
+    std::string prefijo = obtenerEntradaString("Prefijo de los archivos: ");
+    const PlantillaExamen &plantilla =
+        formato == 1 ? PlantillaExamen::latex() : PlantillaExamen::html();
+    std::string extension = formato == 1 ? ".tex" : ".html";
+
+    std::vector<std::string> estudiantes;
+    for (int i = 1; i <= variantes; ++i) {
+      estudiantes.push_back("Estudiante " + std::to_string(i));
+    }
+    std::uint64_t semilla = std::random_device{}();
+    std::atomic<int> fallidos{0};
+    RenderizadorExamenes::renderizarLote(
+        preguntas, plantilla, titulo, estudiantes, semilla,
+        [&](std::size_t i, const std::string &examen,
+            const std::string &clave) {
+          std::string base = prefijo + "_" + std::to_string(i + 1);
+          std::ofstream archivoExamen(base + extension);
+          std::ofstream archivoClave(base + "_pauta" + extension);
+          archivoExamen << examen;
+          archivoClave << clave;
+          if (!archivoExamen || !archivoClave) {
+            fallidos++;
+          }
+        });
+
+    if (fallidos > 0) {
+      std::cout << "Error: No se pudieron escribir " << fallidos
+                << " variantes.\n";
+    } else {
+      std::cout << "Se exportaron " << variantes
+                << " variantes con sus pautas (semilla " << semilla << ").\n";
+    }
+
+    esperarEnter();
+  }
+
+  // Método para agrupar el banco por tema según el texto de las preguntas
+  void agruparPorTema() {
+    limpiarPantalla();
+    std::cout << "===== Agrupar Preguntas por Tema =====\n";
+
+    if (gestor.estaVacio()) {
+      std::cout << "No hay preguntas disponibles.\n";
+      esperarEnter();
+      return;
+    }
+
+    int temas = obtenerEntradaInt("Cantidad de temas (1-50): ", 1, 50);
+    agrupador.entrenar(gestor, temas);
+
+    for (int grupo = 0; grupo < static_cast<int>(agrupador.getCantidadGrupos());
+         ++grupo) {
+      std::cout << "\nTema " << (grupo + 1) << ":\n";
+      for (const Pregunta &p : gestor.vistaPorGrupoTematico(grupo)) {
+        std::cout << "  ID: " << p.getId() << " - "
+                  << p.getTexto().substr(0, 50)
+                  << (p.getTexto().length() > 50 ? "..." : "") << "\n";
+      }
+    }
+    std::cout << "\nLa asignación se puede deshacer con la opción 8.\n";
+
+    esperarEnter();
+  }
+
+  // Método para leer un archivo de respuestas de estudiantes (formato de
+  // ArchivoRespuestas): registra los tiempos observados y estima los
+  // parámetros IRT de las preguntas
+  void cargarRespuestas() {
+    limpiarPantalla();
+    std::cout << "===== Cargar Respuestas de Estudiantes =====\n";
+
+    std::string ruta =
+        obtenerEntradaString("Ingrese la ruta del archivo de respuestas: ");
+    ArchivoRespuestas archivo(ruta);
+    if (!archivo.estaAbierto()) {
+      std::cout << "Error: No se pudo leer el archivo.\n";
+      esperarEnter();
+      return;
+    }
+    CalibradorIRT calibrador;
+    RegistroTiemposRespuesta lote; // Se fusiona al final en 'tiempos'
+    long long conTiempo = 0;
+    RespuestaEstudiante respuesta;
+    while (archivo.siguiente(respuesta)) {
+      calibrador.agregar(respuesta);
+      conTiempo += lote.registrar(respuesta) ? 1 : 0;
+    }
+    tiempos.fusionar(lote);
+    int minimo = obtenerEntradaInt(
+        "Mínimo de respuestas por pregunta (1-10000): ", 1, 10000);
+    int cambiadas = gestor.asignarParametrosIRT(calibrador.calibrar(minimo));
+
+    std::cout << "Se leyeron " << calibrador.getCantidadRespuestas()
+              << " respuestas de " << calibrador.getCantidadEstudiantes()
+              << " estudiantes (" << archivo.getInvalidas()
+              << " líneas inválidas), " << conTiempo << " con tiempo.\n";
+    std::cout << "Se actualizaron los parámetros IRT de " << cambiadas
+              << " preguntas.\n";
+    if (cambiadas > 0) {
+      std::cout << "La calibración se puede deshacer con la opción 8.\n";
+    }
+
+    esperarEnter();
+  }
+
+  // Método para mostrar el enunciado y las alternativas de una pregunta sin
+  // revelar la respuesta correcta
+  void mostrarEnunciado(const Pregunta &p) {
+    std::cout << p.getTexto() << "\n";
+    if (auto *pom = dynamic_cast<const PreguntaOpcionMultiple *>(&p)) {
+      const auto &opciones = pom->getOpciones();
+      for (int k = 0; k < static_cast<int>(opciones.size()); ++k) {
+        std::cout << "  " << PlantillaExamen::etiqueta(k, 'a') << ") "
+                  << opciones[k] << "\n";
+      }
+    } else if (dynamic_cast<const PreguntaVerdaderoFalso *>(&p)) {
+      std::cout << "  Verdadero / Falso\n";
+    } else if (auto *pe = dynamic_cast<const PreguntaEmparejamiento *>(&p)) {
+      const auto &izquierda = pe->getElementosIzquierda();
+      const auto &derecha = pe->getElementosDerecha();
+      for (std::size_t k = 0; k < izquierda.size(); ++k) {
+        std::cout << "  " << (k + 1) << ". " << izquierda[k] << "\n";
+      }
+      for (int k = 0; k < static_cast<int>(derecha.size()); ++k) {
+        std::cout << "  " << PlantillaExamen::etiqueta(k, 'A') << ") "
+                  << derecha[k] << "\n";
+      }
+    }
+  }
+
+  // Método para comparar respuestas sin distinguir mayúsculas ni espacios
+  static std::string normalizarRespuesta(const std::string &respuesta) {
+    std::string normalizada;
+    for (unsigned char c : respuesta) {
+      if (!std::isspace(c)) {
+        normalizada += static_cast<char>(std::tolower(c));
+      }
+    }
+    return normalizada;
+  }
+
+  // Método para rendir un test adaptativo: cada pregunta se elige según la
+  // habilidad estimada con las respuestas anteriores
+  void rendirTestAdaptativo() {
+    limpiarPantalla();
+    std::cout << "===== Rendir un Test Adaptativo =====\n";
+
+    MotorTestAdaptativo motor(gestor);
+    RestriccionesTest restricciones;
+    restricciones.maxPreguntas =
+        obtenerEntradaInt("Máximo de preguntas (1-100): ", 1, 100);
+    restricciones.errorObjetivo = 0.3;
+    auto sesion = motor.crearSesion(restricciones);
+
+    int numero = 0;
+    for (int id = sesion->siguientePregunta(); id != -1;
+         id = sesion->siguientePregunta()) {
+      const Pregunta *p = gestor.getPregunta(id);
+      if (!p) {
+        sesion->registrarRespuesta(false); // Eliminada tras crear el motor
+        continue;
+      }
+      std::cout << "\nPregunta " << ++numero << ":\n";
+      mostrarEnunciado(*p);
+      std::string correcta = p->getRespuesta({});
+      std::string respuesta = obtenerEntradaString(
+          "Respuesta (letra, Verdadero/Falso o pares como 1-A, 2-B): ");
+      bool acierto =
+          normalizarRespuesta(respuesta) == normalizarRespuesta(correcta);
+      std::cout << (acierto ? "Correcta." : "Incorrecta. Era: " + correcta)
+                << "\n";
+      sesion->registrarRespuesta(acierto);
+    }
+
+    if (numero == 0) {
+      std::cout << "No hay preguntas disponibles.\n";
+    } else {
+      std::cout << "\nHabilidad estimada: " << sesion->getTheta()
+                << " (error estándar " << sesion->getErrorEstandar()
+                << ")\n";
+    }
+
+    esperarEnter();
+  }
+
+  // Método para deshacer el último cambio del banco
+  void deshacerCambio() {
+    limpiarPantalla();
+    std::cout << "===== Deshacer el Último Cambio =====\n";
+
+    if (!gestor.puedeDeshacer()) {
+      std::cout << "No hay cambios para deshacer.\n";
+    } else if (gestor.deshacer()) {
+      std::cout << "Cambio deshecho exitosamente.\n";
+    } else {
+      std::cout << "Error: No se pudo deshacer el cambio. La versión anterior "
+                   "es similar a otra pregunta existente.\n";
+    }
+
+    esperarEnter();
+  }
+
+  // Método para rehacer el último cambio deshecho
+  void rehacerCambio() {
+    limpiarPantalla();
+    std::cout << "===== Rehacer el Último Cambio =====\n";
+
+    if (!gestor.puedeRehacer()) {
+      std::cout << "No hay cambios para rehacer.\n";
+    } else if (gestor.rehacer()) {
+      std::cout << "Cambio rehecho exitosamente.\n";
+    } else {
+      std::cout << "Error: No se pudo rehacer el cambio. La pregunta es "
+                   "similar a otra existente.\n";
+    }
 
     esperarEnter();
   }
 };
 
-int main() {
+// Las pruebas (pruebas/pruebas.cpp) incluyen este archivo con BANCO_SIN_MAIN
+// para usar sus clases con su propio main
+#ifndef BANCO_SIN_MAIN
+int main(int argc, char *argv[]) {
+  // Con argumentos se ejecutan las herramientas de exportación, de reporte
+  // de compresión, de pruebas de rendimiento o de sincronización de bancos
+  if (argc > 1) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    if (args[0] == "--exportar-columnar") {
+      return ExportadorAnalitico::ejecutar(args);
+    }
+    if (args[0] == "--reporte-compresion") {
+      return ReporteCompresion::ejecutar(args);
+    }
+    if (args[0] == "--bench-particionado" || args[0] == "--bench-escaneo") {
+      return PruebasRendimiento::ejecutar(args);
+    }
+    return SincronizadorBancos::ejecutar(args);
+  }
+
   InterfazUsuario ui;
   ui.manejarEntradaUsuario();
 
   std::cout << "¡Gracias por usar el Sistema de Gestión de Preguntas basado en "
                "la Taxonomía de Bloom!\n";
   return 0;
-}
\ No newline at end of file
+}
+#endif
@@ -0,0 +1,1062 @@
+// Pruebas de comportamiento del banco de preguntas. Cada grupo prueba un
+// subsistema; sin argumentos se ejecutan todos y con un nombre solo ese grupo.
+#include "main.cpp"
+#include <ctime>
+
+namespace {
+
+int fallas = 0;
+
+// Registra una falla sin detener el grupo, para ver todas las que ocurran
+#define VERIFICAR(condicion)                                                  \
+  do {                                                                        \
+    if (!(condicion)) {                                                       \
+      std::cerr << __FILE__ << ":" << __LINE__ << ": falló " #condicion "\n"; \
+      ++fallas;                                                               \
+    }                                                                         \
+  } while (0)
+
+std::unique_ptr<Pregunta> opcionMultiple(const std::string &texto, int nivel,
+                                         int anio = 0, int tiempo = 5) {
+  return std::make_unique<PreguntaOpcionMultiple>(
+      0, texto, nivel, tiempo,
+      std::vector<std::string>{texto + " a", texto + " b", texto + " c"}, 1,
+      anio);
+}
+
+std::unique_ptr<Pregunta> emparejamiento(const std::string &texto, int nivel,
+                                         int anio = 0) {
+  return std::make_unique<PreguntaEmparejamiento>(
+      0, texto, nivel, 4, std::vector<std::string>{"uno", "dos"},
+      std::vector<std::string>{"one", "two"}, std::vector<int>{0, 1}, anio);
+}
+
+// Los rangos del gestor entregan referencias y los resultados de búsqueda,
+// punteros compartidos (gestor particionado): ids() acepta ambos
+int idDe(const Pregunta &p) { return p.getId(); }
+int idDe(const std::shared_ptr<const Pregunta> &p) { return p->getId(); }
+
+std::vector<int> ids(auto &&rango) {
+  std::vector<int> resultado;
+  for (const auto &p : rango) {
+    resultado.push_back(idDe(p));
+  }
+  return resultado;
+}
+
+std::string rutaTemporal(const std::string &nombre) {
+  return "pruebas_" + nombre + ".tmp";
+}
+
+// Altas, validación de repetidas, actualización, bajas y vistas
+void probarGestor() {
+  GestorPreguntas gestor;
+  int a = gestor.agregarPregunta(opcionMultiple("Capital de Chile", 1, 2023));
+  int b = gestor.agregarPregunta(opcionMultiple("Capital de Perú", 2, 2024));
+  int c = gestor.agregarPregunta(emparejamiento("Traducir", 2));
+  VERIFICAR(a == 1 && b == 2 && c == 3);
+  VERIFICAR(gestor.agregarPregunta(opcionMultiple("Capital de Chile", 3)) ==
+            -1);
+
+  VERIFICAR(gestor.contarPorNivelBloom(2) == 2);
+  VERIFICAR(gestor.contarPorAnio(2024) == 1);
+  VERIFICAR(ids(gestor.vistaPorNivelBloom(2)) == (std::vector<int>{2, 3}));
+
+  VERIFICAR(gestor.actualizarPregunta(b, opcionMultiple("Capital de Bolivia",
+                                                        4, 2024)));
+  VERIFICAR(gestor.getPregunta(b)->getTexto() == "Capital de Bolivia");
+  VERIFICAR(!gestor.actualizarPregunta(b, opcionMultiple("Traducir", 4)));
+  VERIFICAR(gestor.getPregunta(b)->getTexto() == "Capital de Bolivia");
+
+  VERIFICAR(gestor.eliminarPregunta(a));
+  VERIFICAR(!gestor.eliminarPregunta(a));
+  VERIFICAR(ids(gestor.vistaPreguntas()) == (std::vector<int>{2, 3}));
+
+  // El cursor sigue siendo válido aunque cambie el banco entre páginas
+  for (int i = 0; i < 10; ++i) {
+    gestor.agregarPregunta(opcionMultiple("Página " + std::to_string(i), 1));
+  }
+  CursorPreguntas cursor;
+  std::vector<int> vistos;
+  while (true) {
+    std::vector<int> pagina = ids(gestor.paginaDesde(cursor, 4));
+    if (pagina.empty()) {
+      break;
+    }
+    if (vistos.empty()) {
+      gestor.eliminarPregunta(pagina.back() + 1);
+    }
+    vistos.insert(vistos.end(), pagina.begin(), pagina.end());
+    cursor.ultimoId = pagina.back();
+  }
+  VERIFICAR(vistos.size() == gestor.getCantidadPreguntas());
+  VERIFICAR(std::ranges::is_sorted(vistos));
+
+  // Las vistas y las consultas son de solo lectura
+  using Elemento = std::ranges::range_reference_t<
+      decltype(gestor.vistaPreguntas())>;
+  static_assert(std::is_same_v<Elemento, const Pregunta &>);
+  static_assert(std::is_same_v<decltype(gestor.getPregunta(1)),
+                               const Pregunta *>);
+}
+
+// Deshacer, rehacer e historial de versiones
+void probarVersiones() {
+  GestorPreguntas gestor;
+  int id = gestor.agregarPregunta(opcionMultiple("Original", 1));
+  gestor.actualizarPregunta(id, opcionMultiple("Editada", 2));
+  VERIFICAR(gestor.getHistorial(id).size() == 2);
+
+  VERIFICAR(gestor.deshacer());
+  VERIFICAR(gestor.getPregunta(id)->getTexto() == "Original");
+  VERIFICAR(gestor.rehacer());
+  VERIFICAR(gestor.getPregunta(id)->getTexto() == "Editada");
+
+  gestor.eliminarPregunta(id);
+  VERIFICAR(gestor.getPregunta(id) == nullptr);
+  VERIFICAR(gestor.deshacer());
+  VERIFICAR(gestor.getPregunta(id) != nullptr);
+
+  // Cada cambio agrega una versión, también al deshacer y al rehacer
+  const auto &versiones = gestor.getHistorial(id);
+  VERIFICAR(versiones.size() == 6);
+  VERIFICAR(versiones.back().pregunta->getTexto() == "Editada");
+
+  // Fechas y secuencias del historial nunca retroceden
+  for (std::size_t i = 1; i < versiones.size(); ++i) {
+    VERIFICAR(versiones[i - 1].fecha <= versiones[i].fecha);
+    VERIFICAR(versiones[i - 1].secuencia < versiones[i].secuencia);
+  }
+  VERIFICAR(gestor.getVersionEn(id, versiones.back().fecha) ==
+            versiones.back().pregunta);
+
+  // Consultas exactas por número de cambio, aunque compartan la fecha
+  std::uint64_t antes = gestor.getSecuenciaCambios();
+  int otra = gestor.agregarPregunta(opcionMultiple("Otra", 3));
+  gestor.actualizarPregunta(otra, opcionMultiple("Otra editada", 3));
+  VERIFICAR(!gestor.getVersionEnSecuencia(otra, antes));
+  VERIFICAR(gestor.getVersionEnSecuencia(otra, antes + 1)->getTexto() ==
+            "Otra");
+  VERIFICAR(gestor.getVersionEnSecuencia(otra, antes + 2)->getTexto() ==
+            "Otra editada");
+  VERIFICAR(gestor.getBancoEnSecuencia(antes).size() == 1);
+  VERIFICAR(gestor.getBancoEnSecuencia(antes + 1).size() == 2);
+  VERIFICAR(gestor.getBancoEnSecuencia(1).front()->getTexto() == "Original");
+
+  // Un cambio de metadatos no copia el texto: la versión nueva lo comparte
+  // con la anterior y el banco guarda la misma versión que el historial
+  VERIFICAR(gestor.asignarGruposTematicos({{otra, 4}}) == 1);
+  const auto &cambios = gestor.getHistorial(otra);
+  VERIFICAR(gestor.getPregunta(otra) == cambios.back().pregunta.get());
+  VERIFICAR(&cambios.back().pregunta->getTextoGuardado() ==
+            &cambios[cambios.size() - 2].pregunta->getTextoGuardado());
+}
+
+// Aciertos y desalojo preciso de la caché de búsquedas
+void probarCache() {
+  GestorPreguntas gestor;
+  gestor.agregarPregunta(opcionMultiple("Uno", 1, 2020));
+  gestor.agregarPregunta(opcionMultiple("Dos", 2, 2021));
+
+  VERIFICAR(gestor.buscarPorNivelBloom(1).size() == 1);
+  VERIFICAR(gestor.buscarPorNivelBloom(1).size() == 1);
+  VERIFICAR(gestor.getEstadisticasCache().aciertos == 1);
+
+  gestor.agregarPregunta(opcionMultiple("Tres", 1, 2022));
+  VERIFICAR(gestor.buscarPorNivelBloom(1).size() == 2);
+  VERIFICAR(gestor.buscarPorAnio(2021).size() == 1);
+
+  ConsultaPreguntas consulta;
+  consulta.nivelBloom = 1;
+  consulta.anio = 2022;
+  VERIFICAR(gestor.buscar(consulta).size() == 1);
+  VERIFICAR(gestor.buscar(ConsultaPreguntas{}).size() == 3);
+
+  // Las consultas inválidas no ocupan ni devuelven la entrada de "todas"
+  VERIFICAR(gestor.buscarPorNivelBloom(7).empty());
+  VERIFICAR(gestor.buscar(ConsultaPreguntas{0}).empty());
+  VERIFICAR(gestor.buscarPorAnio(-5).empty());
+  VERIFICAR(gestor.buscar(ConsultaPreguntas{}).size() == 3);
+  GestorPreguntas vacio;
+  VERIFICAR(vacio.buscarPorNivelBloom(9).empty());
+  vacio.agregarPregunta(opcionMultiple("Cuatro", 2, 2023));
+  VERIFICAR(vacio.buscar(ConsultaPreguntas{}).size() == 1);
+  VERIFICAR(vacio.buscarPorAnio(2023).size() == 1);
+
+  // Dos consultas con la misma clave filtran lo mismo
+  ConsultaPreguntas invalida{7, 2023};
+  ConsultaPreguntas delAnio{ConsultaPreguntas::CUALQUIERA, 2023};
+  VERIFICAR(invalida.getClave() != delAnio.getClave());
+}
+
+// Particiones, búsquedas dispersas y validación entre particiones
+void probarParticionado() {
+  PoolHilos pool(4);
+  GestorPreguntasParticionado gestor(pool);
+  for (int i = 0; i < 60; ++i) {
+    gestor.agregarPregunta(opcionMultiple("P" + std::to_string(i), 1 + i % 6,
+                                          2018 + i % 5));
+  }
+  VERIFICAR(gestor.getCantidadParticiones() == 5);
+  VERIFICAR(gestor.agregarPregunta(opcionMultiple("P7", 1, 2030)) == -1);
+
+  auto nivel = gestor.buscarPorNivelBloom(3);
+  VERIFICAR(nivel.size() == 10);
+  VERIFICAR(std::ranges::is_sorted(ids(nivel)));
+  VERIFICAR(gestor.buscarPorAnio(2019).size() == 12);
+
+  VERIFICAR(gestor.actualizarPregunta(1, opcionMultiple("Nueva", 6, 2040)));
+  VERIFICAR(gestor.getCantidadParticiones() == 6);
+  VERIFICAR(gestor.buscarPorAnio(2040).size() == 1);
+  VERIFICAR(gestor.eliminarPregunta(1));
+  VERIFICAR(gestor.getCantidadPreguntas() == 59);
+  VERIFICAR(gestor.calcularTiempoTotal() == 59 * 5);
+
+  // Los niveles fuera de 1-6 se rechazan antes de tocar los índices
+  VERIFICAR(gestor.agregarPregunta(opcionMultiple("Nivel 0", 0)) == -1);
+  VERIFICAR(gestor.agregarPregunta(opcionMultiple("Nivel 9", 9)) == -1);
+  VERIFICAR(!gestor.actualizarPregunta(2, opcionMultiple("Nivel 7", 7)));
+  VERIFICAR(gestor.getPregunta(2)->getNivelBloom() == 2);
+
+  // Lo devuelto sigue siendo válido después de actualizar o eliminar
+  auto instantanea = gestor.getPregunta(2);
+  auto delNivel = gestor.buscarPorNivelBloom(2);
+  VERIFICAR(gestor.actualizarPregunta(2, opcionMultiple("Otra", 2, 2018)));
+  VERIFICAR(gestor.eliminarPregunta(2));
+  VERIFICAR(!gestor.getPregunta(2));
+  VERIFICAR(instantanea->getTexto() == "P1");
+  VERIFICAR(delNivel.front()->getTexto() == "P1");
+
+  // El índice de repetidas sigue las altas, cambios y bajas; con una clave
+  // que no es el año las búsquedas por año se enrutan por el conteo
+  GestorPreguntasParticionado porNivel(
+      pool, [](const Pregunta &p) { return p.getNivelBloom(); });
+  int a = porNivel.agregarPregunta(opcionMultiple("Texto", 1, 2020));
+  VERIFICAR(porNivel.agregarPregunta(opcionMultiple("Texto", 4, 2001)) == -1);
+  VERIFICAR(porNivel.actualizarPregunta(a, opcionMultiple("Texto", 2, 2021)));
+  VERIFICAR(porNivel.buscarPorAnio(2020).empty());
+  VERIFICAR(porNivel.buscarPorAnio(2021).size() == 1);
+  VERIFICAR(porNivel.eliminarPregunta(a));
+  VERIFICAR(porNivel.agregarPregunta(opcionMultiple("Texto", 3, 2022)) > 0);
+
+  // Lectores y escritores a la vez: los resultados siguen ordenados y al
+  // final quedan solo las preguntas iniciales
+  GestorPreguntasParticionado concurrido(pool);
+  PruebasRendimiento::poblar(concurrido, 500);
+  auto contencion = PruebasRendimiento::medirContencion(concurrido, 4, 2, 100);
+  VERIFICAR(contencion.inconsistencias == 0);
+  VERIFICAR(contencion.lecturas == 400);
+  VERIFICAR(contencion.escrituras == 600);
+  VERIFICAR(concurrido.getCantidadPreguntas() == 500);
+  VERIFICAR(concurrido.buscarPorNivelBloom(RECORDAR).size() == 84);
+}
+
+// Pool con robo de trabajo y escaneo paralelo
+void probarPool() {
+  PoolHilos pool(4);
+  std::atomic<long long> suma{0};
+  pool.paraCadaBloque(100000, 1000, [&](std::size_t, std::size_t i,
+                                        std::size_t f) {
+    long long parcial = 0;
+    for (std::size_t k = i; k < f; ++k) {
+      parcial += static_cast<long long>(k);
+    }
+    suma += parcial;
+  });
+  VERIFICAR(suma == 100000LL * 99999 / 2);
+
+  // Tareas que esperan subtareas no bloquean el pool
+  auto futuro = pool.enviar([&pool] {
+    std::vector<std::future<int>> hijos;
+    for (int i = 0; i < 16; ++i) {
+      hijos.push_back(pool.enviar([i] { return i; }));
+    }
+    int total = 0;
+    for (auto &hijo : hijos) {
+      total += pool.esperar(hijo);
+    }
+    return total;
+  });
+  VERIFICAR(pool.esperar(futuro) == 120);
+
+  std::vector<int> datos(200000);
+  std::iota(datos.begin(), datos.end(), 0);
+  MotorEscaneoParalelo motor(&pool, 1000, 1000);
+  auto pares = motor.filtrar(
+      datos, [](int x) { return x % 2 == 0; }, [](int x) { return x; });
+  VERIFICAR(pares.size() == 100000 && std::ranges::is_sorted(pares));
+  VERIFICAR(motor.contar(datos, [](int x) { return x < 10; }) == 10);
+
+  // Quien espera tareas largas duerme en vez de girar: mientras las tareas
+  // duermen, el proceso casi no consume CPU
+  PoolHilos lento(2);
+  auto inicioReloj = std::chrono::steady_clock::now();
+  std::clock_t inicioCpu = std::clock();
+  auto largo = lento.enviar([&lento] {
+    auto hijo = lento.enviar([] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(150));
+      return 2;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    return 1 + lento.esperar(hijo);
+  });
+  VERIFICAR(lento.esperar(largo) == 3);
+  double cpu = static_cast<double>(std::clock() - inicioCpu) / CLOCKS_PER_SEC;
+  double pared = std::chrono::duration<double>(
+                     std::chrono::steady_clock::now() - inicioReloj)
+                     .count();
+  VERIFICAR(pared >= 0.15 && cpu < pared / 2);
+}
+
+// Selección adaptativa y estimación de habilidad
+void probarAdaptativo() {
+  GestorPreguntas gestor;
+  for (int i = 0; i < 200; ++i) {
+    auto p = opcionMultiple("Ítem " + std::to_string(i), 1 + i % 6);
+    p->setParametrosIRT(0.5 + (i % 7) * 0.25, -3.0 + 6.0 * i / 199);
+    gestor.cargarPregunta([&] {
+      p->setId(i + 1);
+      return std::move(p);
+    }());
+  }
+  MotorTestAdaptativo motor(gestor);
+  RestriccionesTest restricciones;
+  restricciones.maxPreguntas = 15;
+
+  // Un estudiante que acierta todo termina con habilidad alta
+  auto sesion = motor.crearSesion(restricciones);
+  std::set<int> vistas;
+  for (int id; (id = sesion->siguientePregunta()) > 0;) {
+    VERIFICAR(vistas.insert(id).second);
+    sesion->registrarRespuesta(true);
+  }
+  VERIFICAR(vistas.size() == 15);
+  VERIFICAR(sesion->getTheta() > 1.0);
+
+  // Y uno que falla todo, baja
+  auto otra = motor.crearSesion(restricciones);
+  while (otra->siguientePregunta() > 0) {
+    otra->registrarRespuesta(false);
+  }
+  VERIFICAR(otra->getTheta() < -1.0);
+
+  // Calibración: respuestas simuladas con parámetros conocidos
+  GestorPreguntas banco;
+  std::vector<ParametrosIRT> reales;
+  for (int i = 0; i < 20; ++i) {
+    banco.agregarPregunta(opcionMultiple("Calibrar " + std::to_string(i), 3));
+    reales.push_back({0.6 + (i % 5) * 0.3, -2.0 + 4.0 * i / 19});
+  }
+  std::mt19937 generador(7);
+  std::normal_distribution<double> habilidad;
+  std::uniform_real_distribution<double> azar;
+  CalibradorIRT calibrador;
+  for (int e = 0; e < 2000; ++e) {
+    double theta = habilidad(generador);
+    for (int i = 0; i < 20; ++i) {
+      double p = ModeloIRT::probabilidadAcierto(
+          theta, reales[i].discriminacion, reales[i].dificultad);
+      calibrador.agregar(
+          {"e" + std::to_string(e), i + 1, azar(generador) < p, 0.0, 0.0});
+    }
+  }
+  auto estimados = calibrador.calibrar();
+  VERIFICAR(estimados.size() == 20);
+  double errorB = 0.0, errorA = 0.0;
+  for (const auto &[id, irt] : estimados) {
+    errorB += std::abs(irt.dificultad - reales[id - 1].dificultad) / 20;
+    errorA += std::abs(irt.discriminacion - reales[id - 1].discriminacion) / 20;
+  }
+  VERIFICAR(errorB < 0.25);
+  VERIFICAR(errorA < 0.25);
+  VERIFICAR(calibrador.calibrar(2001).empty());
+
+  // Aplicar la calibración es una operación versionada y deshacible
+  VERIFICAR(banco.asignarParametrosIRT(estimados) == 20);
+  VERIFICAR(banco.getHistorial(1).size() == 2);
+  VERIFICAR(banco.getPregunta(20)->getDificultad() ==
+            estimados.back().second.dificultad);
+  VERIFICAR(banco.asignarParametrosIRT(estimados) == 0);
+  VERIFICAR(banco.asignarParametrosIRT({{1, {-1.0, 0.0}}}) == 0);
+  MotorTestAdaptativo calibrado(banco);
+  auto sesionCalibrada = calibrado.crearSesion(restricciones);
+  VERIFICAR(sesionCalibrada->siguientePregunta() > 0);
+  VERIFICAR(banco.deshacer());
+  VERIFICAR(banco.getPregunta(20)->getDificultad() == 0.0);
+}
+
+// Cuantiles del t-digest y duración estimada de un examen
+void probarTiempos() {
+  TDigest digest;
+  for (int i = 1; i <= 10000; ++i) {
+    digest.agregar(i);
+  }
+  VERIFICAR(std::abs(digest.cuantil(0.5) - 5000) < 100);
+  VERIFICAR(std::abs(digest.cuantil(0.99) - 9900) < 30);
+  VERIFICAR(digest.getCantidadCentroides() < 200);
+
+  GestorPreguntas gestor;
+  gestor.agregarPregunta(opcionMultiple("Uno", 1, 0, 5));
+  gestor.agregarPregunta(opcionMultiple("Dos", 1, 0, 7));
+  RegistroTiemposRespuesta registro;
+  for (int i = 0; i < 1000; ++i) {
+    registro.registrar(1, 3.0 + (i % 3));
+  }
+  VERIFICAR(registro.cuantil(*gestor.getPregunta(2), 0.5) == 7.0);
+  double duracion =
+      registro.estimarDuracionExamen(gestor.vistaPreguntas(), 0.9);
+  VERIFICAR(duracion >= 7.0 + 3.0 && duracion <= 7.0 + 5.0);
+
+  // Consultar un digest const no lo modifica, aunque tenga pendientes
+  TDigest pendiente;
+  for (int i = 1; i <= 100; ++i) {
+    pendiente.agregar(i);
+  }
+  const TDigest &consulta = pendiente;
+  VERIFICAR(std::abs(consulta.cuantil(0.5) - 50) < 5);
+  VERIFICAR(!consulta.estaComprimido());
+  pendiente.comprimir();
+  VERIFICAR(pendiente.estaComprimido());
+
+  // Fusionar consigo mismo no pierde datos ni bloquea
+  digest.fusionar(digest);
+  VERIFICAR(digest.getCantidad() == 10000.0);
+  registro.fusionar(registro);
+  VERIFICAR(registro.cuantil(*gestor.getPregunta(1), 0.5) >= 3.0);
+
+  // Ingesta desde un archivo de respuestas (segundos -> minutos); las
+  // respuestas sin tiempo no se registran
+  std::vector<RespuestaEstudiante> respuestas;
+  for (int i = 0; i < 300; ++i) {
+    respuestas.push_back({"e" + std::to_string(i), 2, true, 1.0,
+                          i % 3 == 0 ? 0.0 : 60.0 * (10 + i % 2)});
+  }
+  std::string ruta = rutaTemporal("tiempos");
+  VERIFICAR(ArchivoRespuestas::guardar(ruta, respuestas));
+  RegistroTiemposRespuesta cargado;
+  VERIFICAR(!cargado.tieneObservaciones());
+  VERIFICAR(cargado.cargarRespuestas(ruta) == 200);
+  VERIFICAR(cargado.cargarRespuestas(rutaTemporal("no_existe")) == -1);
+  std::remove(ruta.c_str());
+  VERIFICAR(cargado.tieneObservaciones());
+  double mediana = cargado.cuantil(*gestor.getPregunta(2), 0.5);
+  VERIFICAR(mediana >= 10.0 && mediana <= 11.0);
+  VERIFICAR(cargado.cuantil(*gestor.getPregunta(1), 0.5) == 5.0);
+
+  // Consultas y registros concurrentes sobre el mismo registro
+  std::vector<std::thread> hilos;
+  std::atomic<int> fueraDeRango{0};
+  for (int h = 0; h < 4; ++h) {
+    hilos.emplace_back([&, h] {
+      for (int i = 0; i < 200; ++i) {
+        if (h % 2 == 0) {
+          cargado.registrar(2, 10.5);
+        } else {
+          double d = cargado.estimarDuracionExamen(gestor.vistaPreguntas(),
+                                                   0.5, 50);
+          fueraDeRango += d < 15.0 || d > 16.0;
+        }
+      }
+    });
+  }
+  for (auto &hilo : hilos) {
+    hilo.join();
+  }
+  VERIFICAR(fueraDeRango == 0);
+}
+
+// Repaso espaciado SM-2
+void probarRepaso() {
+  PlanificadorRepaso planificador;
+  for (int id = 1; id <= 6; ++id) {
+    planificador.registrarPregunta(id, id);
+  }
+  for (int id = 1; id <= 6; ++id) {
+    VERIFICAR(planificador.introducir(7, id, 0));
+  }
+  VERIFICAR(!planificador.introducir(7, 99, 0));
+  VERIFICAR(planificador.siguientesVencidas(7, 0, 10).size() == 6);
+
+  // Los aciertos alejan el próximo repaso; los fallos lo dejan para mañana
+  planificador.aplicarRevisiones({{7, 1, 5, 0}, {7, 2, 1, 0}});
+  auto manana = planificador.siguientesVencidas(7, 1, 10);
+  VERIFICAR(std::ranges::count(manana, 1) == 1);
+  VERIFICAR(std::ranges::count(manana, 2) == 1);
+  planificador.aplicarRevisiones({{7, 1, 5, 1}});
+  VERIFICAR(std::ranges::count(planificador.siguientesVencidas(7, 2, 10), 1) ==
+            0);
+  VERIFICAR(std::ranges::count(planificador.siguientesVencidas(7, 7, 10), 1) ==
+            1);
+  VERIFICAR(planificador.getCantidadEstados() == 6);
+
+  // Dos fallos el mismo día dejan una sola entrada para la pregunta
+  planificador.aplicarRevisiones({{7, 3, 1, 7}, {7, 3, 0, 7}});
+  auto repetidas = planificador.siguientesVencidas(7, 8, 10);
+  VERIFICAR(std::ranges::count(repetidas, 3) == 1);
+  std::set<int> distintas(repetidas.begin(), repetidas.end());
+  VERIFICAR(distintas.size() == repetidas.size());
+
+  // Al cambiar de nivel, la pregunta sale solo de la cola del nivel nuevo
+  std::array<double, CREAR + 1> soloNivel3{0, 0, 0, 1, 0, 0, 0};
+  std::array<double, CREAR + 1> soloNivel5{0, 0, 0, 0, 0, 1, 0};
+  VERIFICAR(planificador.siguientesVencidas(7, 8, 10, soloNivel3) ==
+            (std::vector<int>{3}));
+  planificador.registrarPregunta(3, 5);
+  VERIFICAR(planificador.siguientesVencidas(7, 8, 10, soloNivel3).empty());
+  auto nivel5 = planificador.siguientesVencidas(7, 8, 10, soloNivel5);
+  VERIFICAR(std::ranges::count(nivel5, 3) == 1);
+  VERIFICAR(std::ranges::count(planificador.siguientesVencidas(7, 8, 10), 3) ==
+            1);
+
+  // Un fallo reinicia las repeticiones sin bajar la facilidad (2.5): tras
+  // tres aciertos el intervalo es 6 * 2.7 = 16 días
+  PlanificadorRepaso sm2;
+  sm2.registrarPregunta(1, 1);
+  VERIFICAR(sm2.introducir(0, 1, 0));
+  sm2.aplicarRevisiones({{0, 1, 0, 0}, {0, 1, 5, 1}, {0, 1, 5, 2}});
+  sm2.aplicarRevisiones({{0, 1, 5, 8}});
+  VERIFICAR(sm2.siguientesVencidas(0, 23, 10).empty());
+  VERIFICAR(sm2.siguientesVencidas(0, 24, 10) == (std::vector<int>{1}));
+}
+
+// Agrupación temática de textos con vocabularios distintos
+void probarAgrupador() {
+  GestorPreguntas gestor;
+  const char *temas[][3] = {{"fotosíntesis", "clorofila", "planta"},
+                            {"integral", "derivada", "función"}};
+  for (int i = 0; i < 40; ++i) {
+    const auto &tema = temas[i % 2];
+    gestor.agregarPregunta(opcionMultiple(
+        std::string(tema[i % 3]) + " " + tema[(i + 1) % 3] + " " +
+            std::to_string(i),
+        1));
+  }
+  AgrupadorTematico agrupador;
+  agrupador.entrenar(gestor, 2);
+  VERIFICAR(agrupador.getCantidadGrupos() == 2);
+  int grupoPar = gestor.getPregunta(1)->getGrupoTematico();
+  int grupoImpar = gestor.getPregunta(2)->getGrupoTematico();
+  VERIFICAR(grupoPar != grupoImpar);
+  for (const Pregunta &p : gestor.vistaPreguntas()) {
+    VERIFICAR(p.getGrupoTematico() ==
+              (p.getId() % 2 == 1 ? grupoPar : grupoImpar));
+  }
+
+  // La asignación es un cambio versionado del banco: genera eventos y se
+  // deshace y rehace como una sola operación
+  auto suscriptor = gestor.suscribirCambios();
+  VERIFICAR(gestor.deshacer());
+  for (const Pregunta &p : gestor.vistaPreguntas()) {
+    VERIFICAR(p.getGrupoTematico() == -1);
+  }
+  VERIFICAR(gestor.rehacer());
+  VERIFICAR(gestor.getPregunta(2)->getGrupoTematico() == grupoImpar);
+  VERIFICAR(gestor.getHistorial(2).back().pregunta->getGrupoTematico() ==
+            grupoImpar);
+  EventoCambio evento;
+  int modificaciones = 0;
+  while (suscriptor->leer(evento) == FlujoCambios::LEIDO) {
+    modificaciones += evento.tipo == CAMBIO_MODIFICACION;
+  }
+  VERIFICAR(modificaciones == 80);
+
+  // Una pregunta nueva se asigna sin reagrupar y también queda versionada
+  int nueva = gestor.agregarPregunta(opcionMultiple("derivada integral", 1));
+  VERIFICAR(agrupador.agregar(gestor, nueva) == grupoImpar);
+  VERIFICAR(gestor.getPregunta(nueva)->getGrupoTematico() == grupoImpar);
+  VERIFICAR(gestor.deshacer());
+  VERIFICAR(gestor.getPregunta(nueva)->getGrupoTematico() == -1);
+  VERIFICAR(agrupador.agregar(gestor, 999) == -1);
+}
+
+// Serialización de preguntas en el archivo de banco
+void probarArchivo() {
+  GestorPreguntas gestor;
+  gestor.agregarPregunta(opcionMultiple("Con\ttab y\nsalto \\", 3, 2022));
+  gestor.agregarPregunta(emparejamiento("Emparejar", 4, 2021));
+  gestor.agregarPregunta(std::make_unique<PreguntaVerdaderoFalso>(
+      0, "Cierto", 2, 1, true, 2020));
+  std::string ruta = rutaTemporal("archivo");
+  VERIFICAR(ArchivoBanco::guardar(ruta, gestor));
+
+  GestorPreguntas copia;
+  VERIFICAR(ArchivoBanco::cargar(ruta, copia) == 3);
+  for (const Pregunta &p : gestor.vistaPreguntas()) {
+    const Pregunta *q = copia.getPregunta(p.getId());
+    VERIFICAR(q && ArchivoBanco::serializar(p) ==
+                       ArchivoBanco::serializar(*q));
+  }
+  VERIFICAR(!ArchivoBanco::deserializar("x\tOM\t1"));
+  VERIFICAR(!ArchivoBanco::deserializar("1\tVF\t1\t1\t0\t1\t0\t-1\tT"));
+
+  // Registros con valores fuera de rango se rechazan antes de construir
+  std::string comun = "\t5\t0\t1\t0\t-1\tTexto\t";
+  VERIFICAR(ArchivoBanco::deserializar("1\tOM\t3" + comun + "1\t2\ta\tb"));
+  VERIFICAR(!ArchivoBanco::deserializar("1\tOM\t7" + comun + "1\t2\ta\tb"));
+  VERIFICAR(!ArchivoBanco::deserializar("1\tOM\t0" + comun + "1\t2\ta\tb"));
+  VERIFICAR(!ArchivoBanco::deserializar("1\tOM\t3" + comun + "2\t2\ta\tb"));
+  VERIFICAR(!ArchivoBanco::deserializar("1\tOM\t3" + comun + "-1\t2\ta\tb"));
+  VERIFICAR(!ArchivoBanco::deserializar("1\tVF\t3" + comun + "2"));
+  VERIFICAR(ArchivoBanco::deserializar("1\tEM\t3" + comun +
+                                       "2\t2\tx\ty\tX\tY\t1\t0"));
+  VERIFICAR(!ArchivoBanco::deserializar("1\tEM\t3" + comun +
+                                        "2\t2\tx\ty\tX\tY\t1\t2"));
+  // 2 * nIzquierda + nDerecha desborda a 2 sin la validación de largos
+  VERIFICAR(!ArchivoBanco::deserializar(
+      "1\tEM\t3" + comun + "9223372036854775808\t2\tX\tY"));
+  VERIFICAR(!ArchivoBanco::deserializar(
+      "1\tOM\t3" + comun + "0\t18446744073709551615\ta"));
+  std::remove(ruta.c_str());
+}
+
+// Deltas entre copias de un banco y detección de conflictos
+void probarSincronizacion() {
+  std::map<int, std::string> base;
+  for (int id = 1; id <= 5000; id += 3) {
+    base[id] = "registro " + std::to_string(id);
+  }
+  auto editado = base;
+  editado[4] = "cambiado";
+  editado.erase(7);
+  editado[6000] = "nuevo";
+
+  auto delta = SincronizadorBancos::calcularDelta(base, editado);
+  VERIFICAR(delta.size() == 3);
+
+  auto destino = base;
+  destino[10] = "editado en el destino";
+  editado[10] = "editado en el origen";
+  delta = SincronizadorBancos::calcularDelta(base, editado);
+  auto resultado = SincronizadorBancos::aplicarDelta(destino, delta);
+  VERIFICAR(resultado.aplicados == 3);
+  VERIFICAR(resultado.conflictos == std::vector<int>{10});
+  VERIFICAR(destino[4] == "cambiado" && destino.count(7) == 0 &&
+            destino[6000] == "nuevo");
+
+  // Aplicar dos veces no cambia nada más
+  resultado = SincronizadorBancos::aplicarDelta(destino, delta);
+  VERIFICAR(resultado.aplicados == 0 && resultado.yaPresentes == 3);
+
+  // Entre archivos, los índices guardados junto a cada banco reemplazan la
+  // lectura completa; el resultado es el mismo que con los registros
+  auto conId = [](const std::map<int, std::string> &registros) {
+    std::map<int, std::string> lineas;
+    for (const auto &[id, registro] : registros) {
+      lineas[id] = std::to_string(id) + "\t" + registro;
+    }
+    return lineas;
+  };
+  base = conId(base);
+  editado = conId(editado);
+  delta = SincronizadorBancos::calcularDelta(base, editado);
+  std::string rutaBase = rutaTemporal("base");
+  std::string rutaEditado = rutaTemporal("editado");
+  VERIFICAR(SincronizadorBancos::escribirBanco(rutaBase, base));
+  VERIFICAR(SincronizadorBancos::escribirBanco(rutaEditado, editado));
+  std::vector<SincronizadorBancos::Cambio> desdeArchivos;
+  VERIFICAR(
+      SincronizadorBancos::calcularDelta(rutaBase, rutaEditado, desdeArchivos));
+  VERIFICAR(desdeArchivos.size() == delta.size());
+  for (std::size_t i = 0; i < delta.size() && i < desdeArchivos.size(); ++i) {
+    VERIFICAR(desdeArchivos[i].id == delta[i].id &&
+              desdeArchivos[i].hashAnterior == delta[i].hashAnterior &&
+              desdeArchivos[i].hashNuevo == delta[i].hashNuevo &&
+              desdeArchivos[i].registro == delta[i].registro);
+  }
+
+  // Un índice guardado en el mismo intervalo de fechas en que se escribió
+  // el banco no se usa: una edición del mismo tamaño que conserva la fecha
+  // se detecta igual
+  using ArchivoIndice = SincronizadorBancos::ArchivoIndice;
+  ArchivoIndice archivo;
+  VERIFICAR(!archivo.abrir(rutaEditado, true));
+  auto fecha = std::filesystem::last_write_time(rutaEditado);
+  auto mismoTamano = editado;
+  mismoTamano[4] = "4\tCAMBIADO";
+  {
+    std::ofstream salida(rutaEditado, std::ios::binary);
+    salida << ArchivoBanco::ENCABEZADO << "\n";
+    for (const auto &[id, linea] : mismoTamano) {
+      salida << linea << "\n";
+    }
+  }
+  std::filesystem::last_write_time(rutaEditado, fecha);
+  desdeArchivos.clear();
+  VERIFICAR(
+      SincronizadorBancos::calcularDelta(rutaBase, rutaEditado, desdeArchivos));
+  VERIFICAR(!desdeArchivos.empty() && desdeArchivos[0].id == 4 &&
+            desdeArchivos[0].registro == "4\tCAMBIADO");
+
+  // Con el banco ya asentado el índice se reutiliza: si se altera el hash
+  // de un registro cambiado, la lectura por posición lo detecta
+  for (const std::string &r : {rutaBase, rutaEditado}) {
+    std::filesystem::last_write_time(
+        r, std::filesystem::last_write_time(r) - std::chrono::seconds(10));
+  }
+  desdeArchivos.clear();
+  VERIFICAR(
+      SincronizadorBancos::calcularDelta(rutaBase, rutaEditado, desdeArchivos));
+  VERIFICAR(archivo.abrir(rutaEditado, true));
+  VERIFICAR(archivo.getCantidadRegistros() == mismoTamano.size());
+  SincronizadorBancos::EntradaIndice entrada;
+  VERIFICAR(archivo.buscar(4, entrada) == 1 && archivo.buscar(7, entrada) == 0);
+  SincronizadorBancos::IndiceBanco indice;
+  VERIFICAR(SincronizadorBancos::indexarBanco(rutaEditado, indice));
+  indice[4].hash ^= 1;
+  VERIFICAR(SincronizadorBancos::guardarIndice(rutaEditado, indice));
+  desdeArchivos.clear();
+  VERIFICAR(!SincronizadorBancos::calcularDelta(rutaBase, rutaEditado,
+                                                desdeArchivos));
+  // Al reescribir el banco el índice viejo deja de corresponder
+  editado[4] = "4\tcambiado otra vez";
+  {
+    std::ofstream salida(rutaEditado);
+    for (const auto &[id, linea] : editado) {
+      salida << linea << "\n";
+    }
+  }
+  desdeArchivos.clear();
+  VERIFICAR(
+      SincronizadorBancos::calcularDelta(rutaBase, rutaEditado, desdeArchivos));
+  VERIFICAR(desdeArchivos.size() == 4 && desdeArchivos[0].id == 4 &&
+            desdeArchivos[0].registro == "4\tcambiado otra vez");
+  for (const std::string &ruta : {rutaBase, rutaEditado}) {
+    std::remove(ruta.c_str());
+    std::remove(SincronizadorBancos::rutaIndice(ruta).c_str());
+  }
+
+  // Al leer un delta se valida cada registro: pregunta válida, mismo ID y
+  // hash declarado
+  std::string valido = "3\tVF\t2\t1\t0\t1\t0\t-1\tCierto\t1";
+  std::string ruta = rutaTemporal("delta");
+  std::vector<SincronizadorBancos::Cambio> leido;
+  VERIFICAR(SincronizadorBancos::escribirDelta(
+      ruta,
+      {{3, 0, ArbolMerkle::hashRegistro(valido), valido}, {8, 5, 0, ""}}));
+  VERIFICAR(SincronizadorBancos::leerDelta(ruta, leido) && leido.size() == 2);
+  std::string nivelInvalido = "3\tVF\t9\t1\t0\t1\t0\t-1\tCierto\t1";
+  for (const auto &cambio : std::vector<SincronizadorBancos::Cambio>{
+           {3, 0, ArbolMerkle::hashRegistro(nivelInvalido), nivelInvalido},
+           {4, 0, ArbolMerkle::hashRegistro(valido), valido},
+           {3, 0, 12345, valido},
+           {3, 5, 0, valido}}) {
+    leido.clear();
+    VERIFICAR(SincronizadorBancos::escribirDelta(ruta, {cambio}));
+    VERIFICAR(!SincronizadorBancos::leerDelta(ruta, leido));
+  }
+  std::remove(ruta.c_str());
+}
+
+// Flujo de cambios: orden, imágenes antes/después y pérdida por desborde
+void probarFlujo() {
+  GestorPreguntas gestor(4);
+  auto suscriptor = gestor.suscribirCambios();
+  int id = gestor.agregarPregunta(opcionMultiple("Uno", 1));
+  gestor.actualizarPregunta(id, opcionMultiple("Dos", 1));
+  gestor.eliminarPregunta(id);
+
+  EventoCambio evento;
+  std::vector<TipoCambio> tipos;
+  while (suscriptor->leer(evento) == FlujoCambios::LEIDO) {
+    tipos.push_back(evento.tipo);
+    if (evento.tipo == CAMBIO_MODIFICACION) {
+      VERIFICAR(evento.antes->getTexto() == "Uno");
+      VERIFICAR(evento.despues->getTexto() == "Dos");
+    }
+  }
+  VERIFICAR(tipos == (std::vector<TipoCambio>{CAMBIO_ALTA, CAMBIO_MODIFICACION,
+                                              CAMBIO_BAJA}));
+
+  for (int i = 0; i < 10; ++i) {
+    gestor.agregarPregunta(opcionMultiple("Otra " + std::to_string(i), 1));
+  }
+  VERIFICAR(suscriptor->leer(evento) == FlujoCambios::PERDIDO);
+  VERIFICAR(suscriptor->reanudarDesde(gestor.getSecuenciaCambios()));
+  VERIFICAR(suscriptor->leer(evento) == FlujoCambios::LEIDO);
+
+  // Un cursor posterior al próximo cambio saltaría eventos: se rechaza
+  std::uint64_t siguiente = gestor.getSecuenciaCambios() + 1;
+  VERIFICAR(!suscriptor->reanudarDesde(siguiente + 1));
+  VERIFICAR(suscriptor->getSiguienteSecuencia() == siguiente);
+  VERIFICAR(suscriptor->reanudarDesde(siguiente));
+  VERIFICAR(!gestor.suscribirCambios(siguiente + 1));
+
+  // BLOQUEAR espera a que el suscriptor lea...
+  FlujoCambios bloqueante(4, FlujoCambios::BLOQUEAR,
+                          std::chrono::milliseconds(2000));
+  auto lento = bloqueante.suscribir();
+  for (int i = 1; i <= 4; ++i) {
+    bloqueante.publicar(CAMBIO_ALTA, i, nullptr, nullptr);
+  }
+  std::thread lector([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EventoCambio leido;
+    lento->leer(leido);
+  });
+  bloqueante.publicar(CAMBIO_ALTA, 5, nullptr, nullptr);
+  lector.join();
+  VERIFICAR(bloqueante.getEscriturasForzadas() == 0);
+  VERIFICAR(lento->leer(evento) == FlujoCambios::LEIDO && evento.id == 2);
+
+  // ...pero no para siempre: al agotar la espera sobrescribe
+  FlujoCambios acotado(4, FlujoCambios::BLOQUEAR,
+                       std::chrono::milliseconds(10));
+  auto detenido = acotado.suscribir();
+  auto inicio = std::chrono::steady_clock::now();
+  for (int i = 1; i <= 6; ++i) {
+    acotado.publicar(CAMBIO_ALTA, i, nullptr, nullptr);
+  }
+  auto transcurrido = std::chrono::steady_clock::now() - inicio;
+  VERIFICAR(acotado.getEscriturasForzadas() == 2);
+  VERIFICAR(transcurrido >= std::chrono::milliseconds(20));
+  VERIFICAR(transcurrido < std::chrono::seconds(1));
+  VERIFICAR(detenido->leer(evento) == FlujoCambios::PERDIDO);
+}
+
+// Exportación columnar de las tablas del banco
+void probarColumnar() {
+  GestorPreguntas gestor;
+  for (int i = 0; i < 100; ++i) {
+    gestor.agregarPregunta(opcionMultiple("Texto " + std::to_string(i),
+                                          1 + i % 6, 2020 + i % 3));
+  }
+  std::stringstream tabla;
+  VERIFICAR(ExportadorAnalitico::exportarPreguntas(gestor, tabla, 32));
+  LectorColumnar lector(tabla);
+  VERIFICAR(lector.abrir());
+  VERIFICAR(lector.getCantidadFilas() == 100);
+  VERIFICAR(lector.getCantidadGrupos() == 4);
+  std::vector<FormatoColumnar::ValoresColumna> columnas;
+  VERIFICAR(lector.leerGrupo(1, columnas));
+  VERIFICAR(columnas[0].enteros.front() == 33);
+  VERIFICAR(columnas[9].textos.front() == "Texto 32");
+  VERIFICAR(columnas[5].reales.front() == 1.0);
+  VERIFICAR(lector.getEsquema()[1].tipo == FormatoColumnar::COL_TEXTO);
+  VERIFICAR(tabla.str().substr(0, 4) == "PAR1");
+
+  // Snappy: textos repetitivos se comprimen y los datos dañados se rechazan
+  std::string original;
+  for (int i = 0; i < 5000; ++i) {
+    original += "fila " + std::to_string(i % 37) + ";";
+  }
+  original += std::string(1, '\0') + "fin";
+  std::string comprimido, recuperado;
+  FormatoColumnar::comprimirSnappy(original, comprimido);
+  VERIFICAR(comprimido.size() * 4 < original.size());
+  VERIFICAR(FormatoColumnar::descomprimirSnappy(comprimido, recuperado));
+  VERIFICAR(recuperado == original);
+  VERIFICAR(!FormatoColumnar::descomprimirSnappy(
+      comprimido.substr(0, comprimido.size() - 2), recuperado));
+
+  // Índices del diccionario: rachas largas y grupos empaquetados en bits
+  std::vector<std::uint32_t> indices(100, 3), leidos;
+  for (std::uint32_t i = 0; i < 37; ++i) {
+    indices.push_back(i % 5);
+  }
+  std::string codificados;
+  FormatoColumnar::codificarIndices(indices, 3, codificados);
+  std::size_t posIndices = 0;
+  VERIFICAR(FormatoColumnar::decodificarIndices(codificados, posIndices,
+                                                indices.size(), 3, leidos));
+  VERIFICAR(leidos == indices && posIndices == codificados.size());
+
+  // Los reales se guardan en little-endian sin importar el equipo
+  std::string bytesReal;
+  FormatoColumnar::plano(1.0, bytesReal);
+  VERIFICAR(bytesReal == std::string("\0\0\0\0\0\0\xF0\x3F", 8));
+
+  // Respuestas: del archivo de texto a la tabla, omitiendo líneas inválidas
+  std::string ruta = rutaTemporal("respuestas");
+  std::vector<RespuestaEstudiante> respuestas{
+      {"Ana\tPérez", 1, true, 1.0, 12.5}, {"Luis", 2, false, 0.25, 40.0}};
+  VERIFICAR(ArchivoRespuestas::guardar(ruta, respuestas));
+  {
+    std::ofstream agregar(ruta, std::ios::app);
+    agregar << "Eva\t0\t1\t1\t3\n";
+  }
+  ArchivoRespuestas archivo(ruta);
+  std::stringstream tablaRespuestas;
+  VERIFICAR(ExportadorAnalitico::exportarRespuestas(
+      tablaRespuestas,
+      [&](RespuestaEstudiante &r) { return archivo.siguiente(r); }));
+  VERIFICAR(archivo.getInvalidas() == 1);
+  LectorColumnar lectorRespuestas(tablaRespuestas);
+  VERIFICAR(lectorRespuestas.abrir() &&
+            lectorRespuestas.getCantidadFilas() == 2);
+  VERIFICAR(lectorRespuestas.leerGrupo(0, columnas));
+  VERIFICAR(columnas[0].textos[0] == "Ana\tPérez");
+  VERIFICAR(columnas[2].enteros == (std::vector<std::int64_t>{1, 0}));
+  VERIFICAR(columnas[4].reales[1] == 40.0);
+  std::remove(ruta.c_str());
+}
+
+// Variantes de examen reproducibles por semilla
+void probarExamenes() {
+  GestorPreguntas gestor;
+  for (int i = 0; i < 5; ++i) {
+    gestor.agregarPregunta(opcionMultiple("Pregunta <" + std::to_string(i) +
+                                              ">",
+                                          1));
+  }
+  std::vector<const Pregunta *> preguntas;
+  for (const Pregunta &p : gestor.vistaPreguntas()) {
+    preguntas.push_back(&p);
+  }
+  std::vector<std::string> estudiantes{"Ana", "Luis", "Eva"};
+  auto renderizar = [&](std::uint64_t semilla) {
+    std::vector<std::string> examenes(estudiantes.size());
+    RenderizadorExamenes::renderizarLote(
+        preguntas, PlantillaExamen::html(), "Prueba", estudiantes, semilla,
+        [&](std::size_t i, const std::string &examen, const std::string &) {
+          examenes[i] = examen;
+        });
+    return examenes;
+  };
+  auto primera = renderizar(42);
+  VERIFICAR(primera == renderizar(42));
+  VERIFICAR(primera[0] != primera[1]);
+  VERIFICAR(primera[0].find("Pregunta &lt;0&gt;") != std::string::npos);
+}
+
+// Modo de textos comprimidos
+void probarCompresion() {
+  std::vector<std::string> muestras;
+  for (int i = 0; i < 200; ++i) {
+    muestras.push_back("¿Cuál es la capital de la región número " +
+                       std::to_string(i) + "?");
+  }
+  auto almacen = AlmacenTextos::entrenar(muestras);
+  for (const std::string &texto : muestras) {
+    std::string comprimido = almacen->comprimir(texto);
+    VERIFICAR(comprimido.size() < texto.size());
+    VERIFICAR(almacen->descomprimir(comprimido) == texto);
+  }
+
+  // Los datos dañados se rechazan: código fuera de la tabla o ESCAPE final
+  std::string salida = "sin tocar";
+  std::string escape(1, static_cast<char>(AlmacenTextos::ESCAPE));
+  VERIFICAR(almacen->descomprimir(escape + "x", salida) && salida == "x");
+  salida = "sin tocar";
+  VERIFICAR(!almacen->descomprimir("x" + escape, salida));
+  VERIFICAR(salida == "sin tocar");
+  if (almacen->getCantidadSimbolos() < AlmacenTextos::ESCAPE) {
+    std::string fuera(1, static_cast<char>(almacen->getCantidadSimbolos()));
+    VERIFICAR(!almacen->descomprimir(fuera, salida));
+  }
+
+  // Los textos internados se comparten y salen de la tabla con la última
+  // lista que los usa, también si se internan desde varios hilos
+  {
+    ListaTextos a({"uno", "dos"}, almacen);
+    std::vector<std::thread> hilos;
+    std::vector<ListaTextos> listas(8);
+    for (int h = 0; h < 8; ++h) {
+      hilos.emplace_back([&, h] {
+        for (int i = 0; i < 200; ++i) {
+          listas[h] = ListaTextos({"uno", "dos", std::to_string(i % 5)},
+                                  almacen);
+        }
+      });
+    }
+    for (auto &hilo : hilos) {
+      hilo.join();
+    }
+    VERIFICAR(almacen->getEstadisticas().internados == 3);
+    VERIFICAR(almacen->getEstadisticas().referencias == 2 + 8 * 200 * 3);
+    VERIFICAR(listas[3][2] == "4" && a[1] == "dos");
+  }
+  VERIFICAR(almacen->getEstadisticas().internados == 0);
+  VERIFICAR(almacen->getEstadisticas().bytesInternados == 0);
+
+  GestorPreguntas gestor;
+  VERIFICAR(gestor.setAlmacenTextos(almacen));
+  int id = gestor.agregarPregunta(opcionMultiple(muestras[0], 1));
+  VERIFICAR(gestor.getPregunta(id)->getTexto() == muestras[0]);
+  VERIFICAR(gestor.agregarPregunta(opcionMultiple(muestras[0], 2)) == -1);
+  VERIFICAR(!gestor.setAlmacenTextos(nullptr));
+
+  // Las repetidas se detectan sobre los textos comprimidos: al actualizar,
+  // eliminar y deshacer el índice sigue a la pregunta guardada
+  int otro = gestor.agregarPregunta(opcionMultiple(muestras[1], 3));
+  VERIFICAR(otro > 0);
+  VERIFICAR(!gestor.actualizarPregunta(otro, opcionMultiple(muestras[0], 3)));
+  VERIFICAR(gestor.actualizarPregunta(otro, opcionMultiple(muestras[2], 3)));
+  VERIFICAR(gestor.agregarPregunta(opcionMultiple(muestras[1], 4)) > 0);
+  VERIFICAR(gestor.eliminarPregunta(otro));
+  VERIFICAR(gestor.agregarPregunta(opcionMultiple(muestras[2], 5)) > 0);
+  VERIFICAR(gestor.deshacer() && gestor.deshacer());
+  VERIFICAR(gestor.getPregunta(otro)->getTexto() == muestras[2]);
+  VERIFICAR(gestor.agregarPregunta(opcionMultiple(muestras[2], 6)) == -1);
+
+  // Una versión del historial guardada antes de activar el almacén se
+  // vuelve a guardar con él al deshacer, y sigue contando como repetida
+  GestorPreguntas cambiado;
+  int borrada = cambiado.agregarPregunta(opcionMultiple(muestras[3], 1));
+  VERIFICAR(cambiado.eliminarPregunta(borrada));
+  VERIFICAR(cambiado.setAlmacenTextos(almacen));
+  VERIFICAR(cambiado.deshacer());
+  VERIFICAR(cambiado.getPregunta(borrada)->getAlmacenTextos() == almacen);
+  VERIFICAR(cambiado.getPregunta(borrada)->getTexto() == muestras[3]);
+  VERIFICAR(cambiado.agregarPregunta(opcionMultiple(muestras[3], 2)) == -1);
+
+#ifdef __linux__
+  VERIFICAR(ReporteCompresion::memoriaProceso() > 0);
+#endif
+
+  // Las listas se leen sin copiarlas: los getters entregan la lista y su
+  // iterador descomprime de a un texto
+  static_assert(std::ranges::input_range<const ListaTextos>);
+  static_assert(std::is_same_v<decltype(std::declval<PreguntaOpcionMultiple>()
+                                            .getOpciones()),
+                               const ListaTextos &>);
+  const auto *pom =
+      dynamic_cast<const PreguntaOpcionMultiple *>(gestor.getPregunta(id));
+  VERIFICAR(pom);
+  if (pom) {
+    std::vector<std::string> leidas;
+    for (std::string_view opcion : pom->getOpciones()) {
+      leidas.emplace_back(opcion);
+    }
+    VERIFICAR(leidas == pom->getOpciones().aVector());
+    VERIFICAR(leidas.size() == 3 && leidas[1] == muestras[0] + " b");
+  }
+}
+
+const std::vector<std::pair<std::string, void (*)()>> GRUPOS = {
+    {"gestor", probarGestor},
+    {"versiones", probarVersiones},
+    {"cache", probarCache},
+    {"particionado", probarParticionado},
+    {"pool", probarPool},
+    {"adaptativo", probarAdaptativo},
+    {"tiempos", probarTiempos},
+    {"repaso", probarRepaso},
+    {"agrupador", probarAgrupador},
+    {"archivo", probarArchivo},
+    {"sincronizacion", probarSincronizacion},
+    {"flujo", probarFlujo},
+    {"columnar", probarColumnar},
+    {"examenes", probarExamenes},
+    {"compresion", probarCompresion},
+};
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  bool encontrado = false;
+  for (const auto &[nombre, prueba] : GRUPOS) {
+    if (argc < 2 || nombre == argv[1]) {
+      encontrado = true;
+      prueba();
+    }
+  }
+  if (!encontrado) {
+    std::cerr << "Grupo de pruebas desconocido: " << argv[1] << "\n";
+    return 2;
+  }
+  if (fallas > 0) {
+    std::cerr << fallas << " verificaciones fallaron\n";
+    return 1;
+  }
+  return 0;
+}